@@ -0,0 +1,75 @@
+#include <QtDebug>
+#include "bench.hpp"
+
+// --- BENCH RESULT ---
+
+/**
+ * Get the average duration of one operation
+ *
+ * @return Nanoseconds per operation
+ */
+qreal BenchResult::nsPerOp() const {
+    qint64 ops = iterations * opsPerIteration;
+    return ops > 0 ? qreal(totalNs) / ops : 0;
+}
+
+/**
+ * Get the average duration of one repetition of the measured code
+ *
+ * @return Milliseconds per repetition
+ */
+qreal BenchResult::msPerIteration() const {
+    return iterations > 0 ? totalNs / 1e6 / iterations : 0;
+}
+
+/**
+ * Get the average amount of heap allocations of one repetition of the measured code
+ *
+ * @return Allocations per repetition
+ */
+qreal BenchResult::allocationsPerIteration() const {
+    return iterations > 0 ? qreal(heapAllocations) / iterations : 0;
+}
+
+// --- BENCH CONTEXT ---
+
+/**
+ * Constructor
+ *
+ * @param name Name of the benchmark
+ * @param params Parameters of this run
+ * @param results List to append the measures to
+ */
+BenchContext::BenchContext(const QString& name, const BenchParams& params, QList<BenchResult>* results) :
+    name(name), params(params), results(results)
+{
+
+}
+
+/**
+ * Get the parameters of this run
+ *
+ * @return Parameters of the benchmark
+ */
+const BenchParams& BenchContext::getParams() const {
+    return params;
+}
+
+/**
+ * Report a wrong result: the run goes on, but the program exits with an error
+ *
+ * @param message What went wrong
+ */
+void BenchContext::fail(const QString& message) {
+    qWarning().noquote() << name << "failed:" << message;
+    failed = true;
+}
+
+/**
+ * Know whether a check of this run failed
+ *
+ * @return True if fail() was called
+ */
+bool BenchContext::hasFailed() const {
+    return failed;
+}
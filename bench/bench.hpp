@@ -0,0 +1,91 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include "../include/allocationCounter.hpp"
+
+// Parameters of one run of a benchmark
+struct BenchParams {
+    qsizetype entities = 1000;      // Amount of entities (or of operations for non-scene benchmarks)
+    qreal missileRatio = 0;         // Share of missiles among the entities, the rest are mobs
+    qreal cellSize = 128;           // Cell size of the spatial hash
+    qint64 minTimeMs = 200;         // Each measure repeats until it lasted at least this long
+};
+
+// Result of one measure
+struct BenchResult {
+    QString name;
+    BenchParams params;
+    qint64 iterations;      // Repetitions of the measured code
+    qint64 opsPerIteration; // Operations done by one repetition
+    qint64 totalNs;
+    qint64 heapAllocations; // Calls to the global operator new during the measure
+
+    qreal nsPerOp() const;
+    qreal msPerIteration() const;
+    qreal allocationsPerIteration() const;
+};
+
+// Handed to benchmark functions: holds the parameters and collects the measures
+class BenchContext {
+private:
+    QString name;
+    BenchParams params;
+    QList<BenchResult>* results;
+    bool failed = false;
+
+public:
+    BenchContext(const QString& name, const BenchParams& params, QList<BenchResult>* results);
+
+    const BenchParams& getParams() const;
+    void fail(const QString& message);
+    bool hasFailed() const;
+
+    /**
+     * Repeat a piece of code until the minimum measure time is reached, then record the average
+     *
+     * @param label Suffix of the result name, empty to use the benchmark name only
+     * @param opsPerIteration Operations done by one call of fn (e.g. entities processed)
+     * @param fn Code to measure
+     */
+    template <typename F>
+    void measure(const QString& label, qint64 opsPerIteration, F fn) {
+        fn();   // Warm-up: caches, first allocations
+
+        QElapsedTimer timer;
+        qint64 iterations = 0;
+        qint64 heapBefore = AllocationCounter::getAllocations();
+        timer.start();
+        do {
+            fn();
+            iterations++;
+        } while (timer.elapsed() < params.minTimeMs);
+
+        BenchResult result;
+        result.name = label == "" ? name : name + "/" + label;
+        result.params = params;
+        result.iterations = iterations;
+        result.opsPerIteration = opsPerIteration;
+        result.totalNs = timer.nsecsElapsed();
+        result.heapAllocations = AllocationCounter::getAllocations() - heapBefore;
+        results->append(result);
+    }
+};
+
+typedef void (*BenchFunction)(BenchContext& context);
+
+// Declared benchmark. Scene benchmarks run once per entity mix, the others once per entity count.
+struct BenchDefinition {
+    QString name;
+    BenchFunction function;
+    bool usesMix;
+};
+
+// Benchmarks of each source file, registered by benchMain.cpp
+void registerCoreBenchmarks(QList<BenchDefinition>* benchmarks);
+void registerSceneBenchmarks(QList<BenchDefinition>* benchmarks);
+
+#endif   // BENCH_HPP
@@ -0,0 +1,158 @@
+#include <iostream>
+#include <iomanip>
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include "bench.hpp"
+#include "../include/spatialHash.hpp"
+
+#define DEFAULT_ENTITIES "1000,5000,20000"
+#define DEFAULT_MISSILE_RATIOS "0,0.5"
+
+/**
+ * Parse a comma separated list of numbers
+ *
+ * @param text The list, e.g. "1000,5000"
+ * @return The numbers. Invalid entries are skipped.
+ */
+static QList<qreal> parseList(const QString& text) {
+    QList<qreal> values;
+    for (const QString& part : text.split(",")) {
+        bool ok = false;
+        qreal value = part.trimmed().toDouble(&ok);
+        if (ok) {
+            values.append(value);
+        }
+    }
+    return values;
+}
+
+/**
+ * Write the results as JSON, so that runs of different commits can be compared
+ *
+ * @param filename File to write to
+ * @param label Free text identifying the run (commit, machine...)
+ * @param results Results of every measure
+ * @return True if written
+ */
+static bool writeJson(const QString& filename, const QString& label, const QList<BenchResult>& results) {
+    QJsonArray array;
+    for (const BenchResult& result : results) {
+        QJsonObject object;
+        object["name"] = result.name;
+        object["entities"] = qint64(result.params.entities);
+        object["missile_ratio"] = result.params.missileRatio;
+        object["cell_size"] = result.params.cellSize;
+        object["iterations"] = result.iterations;
+        object["ops_per_iteration"] = result.opsPerIteration;
+        object["total_ns"] = result.totalNs;
+        object["ms_per_iteration"] = result.msPerIteration();
+        object["ns_per_op"] = result.nsPerOp();
+        object["allocs_per_iteration"] = result.allocationsPerIteration();
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root["label"] = label;
+    root["qt_version"] = QString(qVersion());
+    root["results"] = array;
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open file" << filename;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    // Benchmarks never show a window
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("MALL simulation microbenchmarks");
+    parser.addHelpOption();
+    QCommandLineOption listOption("list", "List the benchmarks and exit.");
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose name contains this text.", "text");
+    QCommandLineOption entitiesOption("entities", "Comma separated entity counts.", "list", DEFAULT_ENTITIES);
+    QCommandLineOption missilesOption("missile-ratio", "Comma separated shares of missiles in scene benchmarks.", "list", DEFAULT_MISSILE_RATIOS);
+    QCommandLineOption cellSizeOption("cell-size", "Cell size of the spatial hash.", "size", QString::number(SpatialHash::DefaultCellSize));
+    QCommandLineOption minTimeOption("min-time", "Minimum duration of each measure, in milliseconds.", "ms", "200");
+    QCommandLineOption jsonOption("json", "Write the results to a JSON file.", "file");
+    QCommandLineOption labelOption("label", "Label stored in the JSON output (commit, machine...).", "text");
+    parser.addOption(listOption);
+    parser.addOption(filterOption);
+    parser.addOption(entitiesOption);
+    parser.addOption(missilesOption);
+    parser.addOption(cellSizeOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(jsonOption);
+    parser.addOption(labelOption);
+    parser.process(app);
+
+    QList<BenchDefinition> benchmarks;
+    registerCoreBenchmarks(&benchmarks);
+    registerSceneBenchmarks(&benchmarks);
+
+    if (parser.isSet(listOption)) {
+        for (const BenchDefinition& benchmark : benchmarks) {
+            std::cout << benchmark.name.toStdString() << std::endl;
+        }
+        return 0;
+    }
+
+    QList<qreal> counts = parseList(parser.value(entitiesOption));
+    QList<qreal> ratios = parseList(parser.value(missilesOption));
+    if (counts.isEmpty() || ratios.isEmpty()) {
+        qWarning() << "Entity counts and missile ratios cannot be empty";
+        return 1;
+    }
+
+    BenchParams baseParams;
+    baseParams.cellSize = parser.value(cellSizeOption).toDouble();
+    baseParams.minTimeMs = parser.value(minTimeOption).toLongLong();
+
+    // Run every benchmark for every parameter combination it uses
+    QList<BenchResult> results;
+    bool failed = false;
+    QString filter = parser.value(filterOption);
+    for (const BenchDefinition& benchmark : benchmarks) {
+        if (filter != "" && !benchmark.name.contains(filter)) {
+            continue;
+        }
+
+        for (qreal count : counts) {
+            for (qreal ratio : benchmark.usesMix ? ratios : QList<qreal> { 0 }) {
+                BenchParams params = baseParams;
+                params.entities = qsizetype(count);
+                params.missileRatio = ratio;
+
+                BenchContext context(benchmark.name, params, &results);
+                benchmark.function(context);
+                failed = failed || context.hasFailed();
+            }
+        }
+    }
+
+    // Summary table
+    std::cout << std::left << std::setw(24) << "benchmark" << std::setw(10) << "entities" << std::setw(10) << "missiles"
+              << std::setw(12) << "iterations" << std::setw(16) << "ms/iteration" << std::setw(16) << "ns/op" << "allocs/iteration" << std::endl;
+    for (const BenchResult& result : results) {
+        std::cout << std::setw(24) << result.name.toStdString() << std::setw(10) << result.params.entities
+                  << std::setw(10) << result.params.missileRatio << std::setw(12) << result.iterations
+                  << std::setw(16) << result.msPerIteration() << std::setw(16) << result.nsPerOp() << result.allocationsPerIteration() << std::endl;
+    }
+
+    if (parser.isSet(jsonOption) && !writeJson(parser.value(jsonOption), parser.value(labelOption), results)) {
+        return 1;
+    }
+    return failed ? 1 : 0;
+}
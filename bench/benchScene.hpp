@@ -0,0 +1,16 @@
+#ifndef BENCHSCENE_HPP
+#define BENCHSCENE_HPP
+
+#include "../include/mainScene.hpp"
+
+// Scene exposing the game loop phases to the benchmarks
+class BenchScene : public MainScene {
+public:
+    using MainScene::MainScene;
+    using MainScene::addEntity;
+    using MainScene::checkCollisions;
+    using MainScene::updateEntities;
+    using MainScene::cleanupScene;
+};
+
+#endif   // BENCHSCENE_HPP
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Check the seeded scenarios of bench/budgets against their committed baselines.
+# Baseline times are relative to a reference workload, so they hold on any machine.
+# The same checks run under CTest: ctest --test-dir build -L budget
+#
+# Usage: bench/budget.sh [build dir] [--update]
+# --update records the current run as the new baselines, in bench/budgets: commit them.
+# Exits with a non-zero status if any scenario is over budget. Scenarios never recorded are skipped.
+
+BUILD_DIR=${1:-build}
+UPDATE=$2
+BUDGET_DIR="$(cd "$(dirname "$0")" && pwd)/budgets"
+
+cd "$BUILD_DIR" || exit 1
+if [ ! -x ./src/Mall ]; then
+    echo "Mall executable not found in $BUILD_DIR/src, build the project first" >&2
+    exit 1
+fi
+
+status=0
+for baseline in "$BUDGET_DIR"/*.json; do
+    if [ "$UPDATE" = "--update" ]; then
+        echo "== $(basename "$baseline"): recording baseline"
+        ./src/Mall --headless --write-budget "$baseline" > /dev/null || status=1
+        continue
+    fi
+
+    echo "== $(basename "$baseline")"
+    output=$(./src/Mall --headless --budget "$baseline")
+    result=$?
+    printf '%s\n' "$output" | sed -n '/^Budget/,$p'
+    [ $result -eq 0 ] || [ $result -eq 77 ] || status=1     # 77: never recorded, skipped
+done
+
+exit $status
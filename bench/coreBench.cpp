@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <QRandomGenerator>
+#include "bench.hpp"
+#include "../include/vector2.hpp"
+#include "../include/vector2Batch.hpp"
+#include "../include/lootTables.hpp"
+#include "../include/mobSpawner.hpp"
+#include "../include/entity/item.hpp"
+#include "../include/entity/player.hpp"
+
+#define BENCH_SEED 42
+
+static volatile qreal sink;     // Keeps results alive so that measured code is not optimized out
+
+/**
+ * Vector2 arithmetic used by every moving entity: difference, normalization, scaling, magnitude
+ */
+static void benchVector2(BenchContext& context) {
+    qsizetype count = context.getParams().entities;
+    QRandomGenerator rng(BENCH_SEED);
+    QList<Vector2> positions;
+    QList<Vector2> targets;
+    for (qsizetype i=0; i<count; i++) {
+        positions.append(Vector2(rng.bounded(1000.0), rng.bounded(1000.0)));
+        targets.append(Vector2(rng.bounded(1000.0), rng.bounded(1000.0)));
+    }
+
+    context.measure("move", count, [&]() {
+        qreal total = 0;
+        for (qsizetype i=0; i<count; i++) {
+            Vector2 movement = (targets.at(i) - positions.at(i)).normalized() * 0.1 * 16;
+            total += (positions.at(i) + movement).magnitude();
+        }
+        sink = total;
+    });
+
+    // Same movement with the batch kernels
+    QList<Vector2> directions(count);
+    QList<qreal> distances(count);
+    QList<Vector2> moved(count);
+    context.measure(QString("move_batch_") + Vector2Batch::getInstructionSet(), count, [&]() {
+        for (qsizetype i=0; i<count; i++) {
+            directions[i] = targets.at(i) - positions.at(i);
+        }
+        Vector2Batch::normalize(directions.data(), count);
+        std::copy(positions.cbegin(), positions.cend(), moved.begin());
+        Vector2Batch::addScaled(moved.data(), directions.constData(), 0.1 * 16, count);
+        Vector2Batch::distance(moved.constData(), targets.constData(), distances.data(), count);
+        sink = count > 0 ? distances.at(count - 1) : 0;
+    });
+
+    context.measure("rotate", count, [&]() {
+        qreal total = 0;
+        for (qsizetype i=0; i<count; i++) {
+            total += positions.at(i).rotate(qreal(i % 360)).getX();
+        }
+        sink = total;
+    });
+}
+
+/**
+ * Random loot rolls, as done on every mob death
+ */
+static void benchLoot(BenchContext& context) {
+    qsizetype count = context.getParams().entities;
+    LootTables::generateTables();
+    LootTables::setSeed(BENCH_SEED);
+
+    context.measure("", count, [&]() {
+        qsizetype found = 0;
+        for (qsizetype i=0; i<count; i++) {
+            found += LootTables::getRandomLoot("common_mob.json").size();
+        }
+        sink = found;
+    });
+}
+
+/**
+ * Item creation from the item cache, as done when a mob drops its loot
+ */
+static void benchItemCreate(BenchContext& context) {
+    qsizetype count = context.getParams().entities;
+    Item::generateCache();
+    LootTables::generateTables();
+    LootTables::setSeed(BENCH_SEED);
+
+    QList<QString> names;
+    for (qsizetype i=0; i<count; i++) {
+        names.append(LootTables::getRandomLoot("rare_mob.json"));
+    }
+
+    context.measure("", count, [&]() {
+        for (qsizetype i=0; i<count; i++) {
+            delete Item::create(names.at(i), Vector2::zero);
+        }
+    });
+}
+
+/**
+ * Mob spawns, each one copied from the spawner cache and placed around the target
+ */
+static void benchSpawner(BenchContext& context) {
+    qsizetype count = context.getParams().entities;
+    Player target(100, 100, 0, 0.5, Vector2::zero, Vector2(50, 100), "player.png", Teams::Player);
+    MobSpawner spawner("level1.json");
+    spawner.setSeed(BENCH_SEED);
+    qint64 sceneTime = 0;
+
+    context.measure("", count, [&]() {
+        for (qsizetype i=0; i<count; i++) {
+            sceneTime += 100;
+            delete spawner.getSpawned(sceneTime, &target);
+        }
+    });
+}
+
+/**
+ * Register the benchmarks of this file
+ *
+ * @param benchmarks List to add the benchmarks to
+ */
+void registerCoreBenchmarks(QList<BenchDefinition>* benchmarks) {
+    benchmarks->append(BenchDefinition { "vector2", &benchVector2, false });
+    benchmarks->append(BenchDefinition { "loot", &benchLoot, false });
+    benchmarks->append(BenchDefinition { "item_create", &benchItemCreate, false });
+    benchmarks->append(BenchDefinition { "spawner", &benchSpawner, false });
+}
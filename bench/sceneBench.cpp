@@ -0,0 +1,163 @@
+#include <cmath>
+#include <QRandomGenerator>
+#include "bench.hpp"
+#include "benchScene.hpp"
+#include "../include/entity/mob.hpp"
+#include "../include/entity/missile.hpp"
+
+#define BENCH_SEED 42
+#define BENCH_SPACING 60.0      // Average distance between two entities: keeps density constant across sizes
+#define MOB_DIMS Vector2(50, 14)
+#define MISSILE_DIMS Vector2(20, 6)
+#define LINEAR_MAX_ENTITIES 5000    // Quadratic check gets too slow past this
+#define STEERING_CHECK_TICKS 120    // Ticks run by both steering paths before comparing their state
+
+/**
+ * Fill the scene with bats and missiles spread on a square area.
+ * Missiles pierce and deal no damage, so the scene stays the same across iterations.
+ * 
+ * @param scene The scene to fill
+ * @param params Amount of entities and share of missiles
+ */
+static void populate(BenchScene* scene, const BenchParams& params) {
+    QRandomGenerator rng(BENCH_SEED);
+    qsizetype count = params.entities;
+    qsizetype missiles = qsizetype(count * params.missileRatio);
+    qreal side = std::sqrt(qreal(count)) * BENCH_SPACING;
+
+    scene->setSeed(BENCH_SEED);
+    scene->setCollisionCellSize(params.cellSize);
+
+    for (qsizetype i=0; i<count; i++) {
+        Vector2 position = Vector2(rng.bounded(side) - side/2, rng.bounded(side) - side/2);
+        if (i < missiles) {
+            Vector2 velocity = Vector2::right.rotate(rng.bounded(360.0)) * 0.5;
+            scene->addEntity(new Missile(velocity, 1e9, 0, true, position, MISSILE_DIMS, "bullet.png", Teams::Player));
+        }
+        else {
+            scene->addEntity(new Mob(3, 1, 0.1, position, MOB_DIMS, "bat.png", Teams::Ennemy, 0, "", scene->getMainPlayer()));
+        }
+    }
+}
+
+/**
+ * Mob steering toward their target, outside of any scene
+ */
+static void benchMobMove(BenchContext& context) {
+    qsizetype count = context.getParams().entities;
+    QRandomGenerator rng(BENCH_SEED);
+    Player target(100, 100, 0, 0.5, Vector2::zero, Vector2(50, 100), "player.png", Teams::Player);
+
+    QList<Mob*> mobs;
+    for (qsizetype i=0; i<count; i++) {
+        Vector2 position = Vector2(rng.bounded(2000.0) - 1000, rng.bounded(2000.0) - 1000);
+        mobs.append(new Mob(3, 1, 0.1, position, MOB_DIMS, "bat.png", Teams::Ennemy, 0, "", &target));
+    }
+
+    context.measure("", count, [&]() {
+        for (Mob* mob : mobs) {
+            mob->moveTowardTarget(MainScene::TickDuration);
+        }
+    });
+
+    QList<Entity*> entities(mobs.cbegin(), mobs.cend());
+    MobSteering steering;
+    context.measure("batch", count, [&]() {
+        steering.steer(entities, MainScene::TickDuration);
+    });
+
+    qDeleteAll(mobs);
+}
+
+/**
+ * Collision check of a whole scene, with the spatial hash and with the linear reference
+ */
+static void benchCollisions(BenchContext& context) {
+    const BenchParams& params = context.getParams();
+    BenchScene scene(nullptr, 60, true);
+    populate(&scene, params);
+
+    scene.setSpatialHashEnabled(true);
+    context.measure("hash", params.entities, [&]() {
+        scene.checkCollisions();
+    });
+
+    if (params.entities <= LINEAR_MAX_ENTITIES) {
+        scene.setSpatialHashEnabled(false);
+        context.measure("linear", params.entities, [&]() {
+            scene.checkCollisions();
+        });
+    }
+}
+
+/**
+ * Update phase of a whole scene, on the thread pool and on the main thread only
+ */
+static void benchUpdate(BenchContext& context) {
+    const BenchParams& params = context.getParams();
+    BenchScene scene(nullptr, 60, true);
+    populate(&scene, params);
+
+    scene.setParallelUpdateEnabled(true);
+    context.measure("parallel", params.entities, [&]() {
+        scene.updateEntities();
+    });
+
+    scene.setParallelUpdateEnabled(false);
+    context.measure("serial", params.entities, [&]() {
+        scene.updateEntities();
+    });
+}
+
+/**
+ * Full simulation tick: collisions, update, cleanup and waves
+ */
+static void benchStep(BenchContext& context) {
+    const BenchParams& params = context.getParams();
+    BenchScene scene(nullptr, 60, true);
+    populate(&scene, params);
+
+    context.measure("", params.entities, [&]() {
+        scene.step(MainScene::TickDuration);
+    });
+}
+
+/**
+ * Full simulation tick with chasing mobs moved in one batched pass and one by one.
+ * Both paths must move mobs the same way: the scenes are compared after the same ticks.
+ */
+static void benchSteering(BenchContext& context) {
+    const BenchParams& params = context.getParams();
+    quint64 checksums[2];
+    for (int batch=1; batch>=0; batch--) {
+        BenchScene scene(nullptr, 60, true);
+        populate(&scene, params);
+        scene.setBatchSteeringEnabled(batch);
+        for (int i=0; i<STEERING_CHECK_TICKS; i++) {
+            scene.step(MainScene::TickDuration);
+        }
+        checksums[batch] = scene.getStateChecksum();
+
+        context.measure(batch ? "batch" : "per_mob", params.entities, [&]() {
+            scene.step(MainScene::TickDuration);
+        });
+    }
+
+    if (checksums[0] != checksums[1]) {
+        context.fail(QString("batched and per-mob steering ended with different states after %1 ticks (%2 vs %3)")
+                     .arg(STEERING_CHECK_TICKS).arg(checksums[1], 0, 16).arg(checksums[0], 0, 16));
+    }
+}
+
+/**
+ * Register the benchmarks of this file
+ *
+ * @param benchmarks List to add the benchmarks to
+ */
+void registerSceneBenchmarks(QList<BenchDefinition>* benchmarks) {
+    benchmarks->append(BenchDefinition { "mob_move", &benchMobMove, false });
+    benchmarks->append(BenchDefinition { "collisions", &benchCollisions, true });
+    benchmarks->append(BenchDefinition { "update", &benchUpdate, true });
+    benchmarks->append(BenchDefinition { "step", &benchStep, true });
+    benchmarks->append(BenchDefinition { "steering", &benchSteering, true });
+}
@@ -0,0 +1,46 @@
+#!/bin/sh
+# Run every stress level headlessly and print how the engine scales with the entity count.
+#
+# Usage: bench/stress.sh [build dir] [ticks] [csv file]
+# Writes one CSV row per level (default: stress.csv in the current directory).
+# The build dir must sit at the root of the project so that ../res is found (default: build).
+
+BUILD_DIR=${1:-build}
+TICKS=${2:-1800}
+CSV=${3:-stress.csv}
+case "$CSV" in
+    /*) ;;
+    *) CSV="$(pwd)/$CSV" ;;
+esac
+LEVELS="stress_1k.json stress_10k.json stress_50k.json stress_bullets.json stress_rockets.json"
+
+cd "$BUILD_DIR" || exit 1
+if [ ! -x ./src/Mall ]; then
+    echo "Mall executable not found in $BUILD_DIR/src, build the project first" >&2
+    exit 1
+fi
+
+# Value of a line of the headless summary, e.g. field "Ticks/sec" output
+field() {
+    printf '%s\n' "$2" | sed -n "s/^$1: *\([^ ]*\).*/\1/p"
+}
+
+echo "level,peak_entities,ticks_per_sec,tick_p99_ms,peak_rss_kb" > "$CSV"
+printf '%-22s %14s %12s %14s %14s\n' "level" "peak entities" "ticks/sec" "tick p99 (ms)" "peak RSS (MB)"
+
+for level in $LEVELS; do
+    output=$(./src/Mall --headless --ticks "$TICKS" --spawner "$level" --seed 1) || {
+        echo "$level: run failed" >&2
+        continue
+    }
+
+    entities=$(printf '%s\n' "$output" | sed -n 's/^Entities: .*(peak \([0-9]*\)).*/\1/p')
+    tps=$(field "Ticks\/sec" "$output")
+    p99=$(field "Tick p99" "$output")
+    rss=$(field "Peak RSS" "$output")
+
+    echo "$level,$entities,$tps,$p99,$rss" >> "$CSV"
+    printf '%-22s %14s %12.1f %14.3f %14.1f\n' "$level" "$entities" "$tps" "$p99" "$(awk "BEGIN { print $rss / 1024 }")"
+done
+
+echo "Results saved to $CSV"
@@ -0,0 +1,72 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <QtGlobal>
+
+// Counts every call to the global operator new, from any thread.
+// Counting only happens in executables that link src/allocationHooks.cpp (the game and
+// the benchmarks), which replaces the global operator new/delete. Elsewhere, isInstalled()
+// is false and the counters stay at 0.
+class AllocationCounter {
+private:
+    static std::atomic<qint64> allocations;
+    static std::atomic<qint64> bytes;
+    static std::atomic<bool> installed;
+
+    AllocationCounter();
+    ~AllocationCounter();
+
+public:
+    /**
+     * Count one allocation. Called by the operator new hooks only.
+     *
+     * @param size Size of the allocation, in bytes
+     */
+    static void record(std::size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(qint64(size), std::memory_order_relaxed);
+    }
+
+    /**
+     * Tell that the hooks are linked. Called by the operator new hooks only.
+     */
+    static void setInstalled() {
+        installed.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Know whether allocations are counted in this executable
+     *
+     * @return True if the operator new hooks are linked
+     */
+    static bool isInstalled() {
+        return installed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the amount of heap allocations since start
+     *
+     * @return Calls to the global operator new
+     */
+    static qint64 getAllocations() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the memory requested from the heap since start
+     *
+     * @return Bytes requested, freed memory included
+     */
+    static qint64 getBytes() {
+        return bytes.load(std::memory_order_relaxed);
+    }
+};
+
+// Initialize static variables
+inline std::atomic<qint64> AllocationCounter::allocations = 0;
+inline std::atomic<qint64> AllocationCounter::bytes = 0;
+inline std::atomic<bool> AllocationCounter::installed = false;
+
+#endif   // ALLOCATIONCOUNTER_HPP
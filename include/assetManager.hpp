@@ -0,0 +1,67 @@
+#ifndef ASSETMANAGER_HPP
+#define ASSETMANAGER_HPP
+
+#include <ostream>
+#include <QtGlobal>
+#include <QCache>
+#include <QHash>
+#include <QMap>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include "textureAtlas.hpp"
+
+// Request counters of the asset manager
+struct AssetStats {
+    qint64 hits = 0;        // Requests served from memory
+    qint64 misses = 0;      // Requests that had to read the disk
+    qint64 preloads = 0;    // Images read ahead of time by preload(), addDecoded() or pin()
+    qint64 evictions = 0;   // Images dropped to stay within budget
+};
+
+// Owner of decoded images for the whole application lifetime.
+// Packed sprites live in the TextureAtlas, built once and never evicted. Other images
+// (backgrounds) are kept in a LRU cache limited by a memory budget, unless pinned.
+// An image bigger than the whole budget is pinned, with a warning.
+// Scaled copies drawn by sprites have their own budget, see Sprite.
+// Nothing is freed when the last sprite using an image dies: only clear(), at exit.
+// Not thread-safe: use from the main thread.
+class AssetManager {
+private:
+    static constexpr qint64 DefaultBudget = 64 * 1024 * 1024;     // Bytes of unpinned, unpacked images
+
+    static QCache<QString, AtlasRegion>* cache;     // Cost is the size of the image in bytes
+    static QHash<QString, AtlasRegion>* pinned;
+    static qint64 budget;
+    static AssetStats stats;
+
+    AssetManager();
+    ~AssetManager();
+
+    static void init();
+    static bool findResident(const QString& fileName, AtlasRegion* region);
+    static AtlasRegion load(const QString& fileName);
+    static void store(const QString& fileName, const AtlasRegion& region);
+    static qint64 getCost(const AtlasRegion& region);
+
+public:
+    static AtlasRegion getImage(const QString& fileName);
+    static void preload(const QStringList& fileNames);
+    static void addDecoded(const QMap<QString, QImage>& images);
+    static bool isResident(const QString& fileName);
+    static void pin(const QString& fileName);
+    static void unpin(const QString& fileName);
+    static void setBudget(qint64 bytes);
+    static qint64 getBudget();
+    static AssetStats getStats();
+    static void print(std::ostream& out);
+    static void clear();
+};
+
+// Initialize static variables
+inline QCache<QString, AtlasRegion>* AssetManager::cache = nullptr;
+inline QHash<QString, AtlasRegion>* AssetManager::pinned = nullptr;
+inline qint64 AssetManager::budget = AssetManager::DefaultBudget;
+inline AssetStats AssetManager::stats;
+
+#endif   // ASSETMANAGER_HPP
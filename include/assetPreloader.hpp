@@ -0,0 +1,49 @@
+#ifndef ASSETPRELOADER_HPP
+#define ASSETPRELOADER_HPP
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QImage>
+#include <QPair>
+#include <QJsonValue>
+#include <QFutureWatcher>
+
+// Decodes every image a scene can need before it starts, so that the first wave of a new
+// mob type does not stall on PNG decoding.
+// Images are listed from items.json, the mob files and the weapon files, plus the few ones
+// named in the code (SpriteNames).
+// Decoding runs on the Qt thread pool; decoded images are handed to AssetManager on the
+// thread owning the preloader, since AssetManager is not thread-safe.
+class AssetPreloader : public QObject {
+    Q_OBJECT
+
+private:
+    using Decoded = QPair<QString, QImage>;
+
+    QFutureWatcher<Decoded>* watcher;
+
+    static void addSprites(const QJsonValue& value, QStringList* fileNames);
+    static void addSpritesOf(const QString& jsonFilename, QStringList* fileNames);
+    static Decoded decode(const QString& fileName);
+    static void install(const QList<Decoded>& images);
+
+    void onDecoded();
+
+public:
+    AssetPreloader(QObject* parent = nullptr);
+    virtual ~AssetPreloader();
+
+    static QStringList listSprites();
+    static QStringList listMissing();
+    static void preloadBlocking();
+
+    void start();
+    bool isRunning() const;
+
+signals:
+    void progress(int done, int total);
+    void finished();
+};
+
+#endif   // ASSETPRELOADER_HPP
@@ -0,0 +1,67 @@
+#ifndef COSTACCOUNTING_HPP
+#define COSTACCOUNTING_HPP
+
+#include <atomic>
+#include <ostream>
+#include <QtGlobal>
+#include "entity/entityKinds.hpp"
+
+namespace CostActivities {
+    enum Activity {
+        Update,     // onUpdate
+        Collide,    // onCollide
+        Paint,      // paint
+        Count       // Amount of activities, not an activity
+    };
+
+    const char* getName(Activity activity);
+}
+
+// Attributes time and calls of the update, collision and paint of entities to their concrete kind.
+// Off by default: while off, measured code only pays one relaxed atomic load.
+// Counters are atomic since updates run on the thread pool.
+class CostAccounting {
+private:
+    struct Counter {
+        std::atomic<qint64> ns = 0;
+        std::atomic<qint64> calls = 0;
+    };
+
+    static constexpr qint64 WindowDuration = 1000;     // Scene milliseconds between two rate updates
+
+    static std::atomic<bool> enabled;
+    static Counter totals[CostActivities::Count][EntityKinds::Count];
+    static qint64 windowStartNs[CostActivities::Count][EntityKinds::Count];
+    static qint64 windowStartCalls[CostActivities::Count][EntityKinds::Count];
+    static qreal nsRates[CostActivities::Count][EntityKinds::Count];        // Per second of the last window
+    static qreal callRates[CostActivities::Count][EntityKinds::Count];
+    static qint64 startTime;            // Scene time of the first frame, -1 before
+    static qint64 windowStartTime;
+    static qint64 lastTime;
+
+    CostAccounting();
+    ~CostAccounting();
+
+public:
+    static bool isEnabled();
+    static void setEnabled(bool enable);
+    static void reset();
+    static void add(CostActivities::Activity activity, EntityKinds::EntityKind kind, qint64 ns, qint64 calls = 1);
+    static void endFrame(qint64 sceneTime);
+    static qreal getTimeRate(CostActivities::Activity activity, EntityKinds::EntityKind kind);
+    static qreal getCallRate(CostActivities::Activity activity, EntityKinds::EntityKind kind);
+    static void print(std::ostream& out);
+};
+
+// Initialize static variables
+inline std::atomic<bool> CostAccounting::enabled = false;
+inline CostAccounting::Counter CostAccounting::totals[CostActivities::Count][EntityKinds::Count];
+inline qint64 CostAccounting::windowStartNs[CostActivities::Count][EntityKinds::Count] = {};
+inline qint64 CostAccounting::windowStartCalls[CostActivities::Count][EntityKinds::Count] = {};
+inline qreal CostAccounting::nsRates[CostActivities::Count][EntityKinds::Count] = {};
+inline qreal CostAccounting::callRates[CostActivities::Count][EntityKinds::Count] = {};
+inline qint64 CostAccounting::startTime = -1;
+inline qint64 CostAccounting::windowStartTime = 0;
+inline qint64 CostAccounting::lastTime = 0;
+
+#endif   // COSTACCOUNTING_HPP
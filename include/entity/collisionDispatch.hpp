@@ -0,0 +1,18 @@
+#ifndef COLLISIONDISPATCH_HPP
+#define COLLISIONDISPATCH_HPP
+
+#include <QtGlobal>
+#include "entityKinds.hpp"
+
+class Entity;
+
+// Double dispatch of collisions on entity kinds.
+// Each (kind of self, kind of other) cell holds the reaction of self, or nothing.
+class CollisionDispatch {
+public:
+    typedef void (*Handler)(Entity* self, Entity* other, qint64 deltaTime);
+
+    static void resolve(Entity* self, Entity* other, qint64 deltaTime);
+};
+
+#endif   // COLLISIONDISPATCH_HPP
@@ -0,0 +1,30 @@
+#ifndef COLLISIONLAYERS_HPP
+#define COLLISIONLAYERS_HPP
+
+#include <QtGlobal>
+#include "entityKinds.hpp"
+#include "teams.hpp"
+
+// Each entity belongs to one layer, given by its category and its team.
+// Its mask holds the layers it reacts to. Two entities are only tested for collision
+// when one of them has the other's layer in its mask.
+namespace CollisionLayers {
+    enum Category {
+        LivingPlayer,
+        LivingMob,
+        Projectile,
+        Zone,
+        Loot,
+        CategoryCount       // Amount of categories, not a category
+    };
+
+    Category categoryOf(EntityKinds::EntityKind kind);
+    quint32 layerBit(Category category, Teams::Team team);
+    quint32 categoryMask(Category category);
+    quint32 opposingMask(Category category, Teams::Team team);
+
+    quint32 layerOf(EntityKinds::EntityKind kind, Teams::Team team);
+    quint32 defaultMask(EntityKinds::EntityKind kind, Teams::Team team);
+}
+
+#endif   // COLLISIONLAYERS_HPP
@@ -5,6 +5,8 @@
 #include "effectType.hpp"
 #include "effect.hpp"
 
+class LivingEntity;
+
 class EffectZone : public Entity {
 private:
     qreal range;
@@ -13,6 +15,7 @@ private:
 protected:
     QString getEffectSprite(Effects::EffectType effectType);
     EffectZone(const EffectZone& other);
+    quint32 computeCollisionMask() const override;
 
 public:
     // Constructor/destructor
@@ -21,9 +24,18 @@ public:
     EffectZone(Effect effect, const Vector2 position, const qreal range);
     ~EffectZone();
 
+    // Pooled allocation
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
+    // Collision handlers, called by CollisionDispatch
+    void affectEntity(Entity* other);
+    void affectLivingEntity(LivingEntity* other);
+
     // Inherited methods
+    EntityKinds::EntityKind getKind() const override;
+    bool canUpdateInParallel() const override;
     QPainterPath shape() const override;
-    void onCollide(Entity* other, qint64 deltaTime) override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
 
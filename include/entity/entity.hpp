@@ -8,19 +8,33 @@
 
 #include "../vector2.hpp"
 #include "../sprite.hpp"
+#include "../spatialHash.hpp"
 #include "teams.hpp"
+#include "entityKinds.hpp"
+#include "entityStore.hpp"
 
 class Entity : public QGraphicsItem {
+    friend class SpatialHash;
+    friend class CollisionDispatch;
+    friend class EntityStore;
+
 private:
-    Vector2 position;
-    Vector2 dimensions;
+    qsizetype storeRow;     // Row holding the components of this entity in EntityStore
+
+    SpatialHash* spatialHash = nullptr;     // Collision grid this entity is registered in, if any
+    SpatialHash::CellRange cellRange;       // Cells covered by this entity in spatialHash
+    bool hashDirty = false;                 // Moved while spatialHash updates were deferred
 
 protected:
     const Sprite* sprite = nullptr;     // sprite object cannot be modified but pointer can
     bool isDeleted = false;     // Set to true when entity is deleted. Ensures entity exists until not needed anymore.
-    Teams::Team team = Teams::None;
 
     Entity(const Entity& other);
+    virtual quint32 computeCollisionMask() const;
+    qsizetype getStoreRow() const;
+    Vector2 getVelocity() const;
+    void setVelocity(const Vector2 newVelocity);
+    void updateSpatialHash();
 
 public:
     // Constructor/destructor
@@ -33,20 +47,37 @@ public:
     Vector2 getCenterPos() const;
     Vector2 getDims() const;
     virtual bool getDeleted() const;
+    virtual qint64 getScoreValue() const;
+    virtual bool canUpdateInParallel() const;
     Teams::Team getTeam() const;
+    virtual EntityKinds::EntityKind getKind() const;
+    quint32 getCollisionLayer() const;
+    quint32 getCollisionMask() const;
 
     // Setters
     void setPos(const Vector2 pos);
     void setDims(const Vector2 dims);
     void setDeleted(const bool del);
     void setSprite(const QString& filename);
+    void setTeam(const Teams::Team newTeam);
+
+    // Simulation/render synchronization
+    void snapshotPosition();
+    void interpolateRender(qreal alpha);
+    bool collidesWithEntity(const Entity* other) const;
+
+    // Collision filtering
+    void updateCollisionLayer();
+    bool canCollideWith(const Entity* other) const;
 
     // --- GRAPHICS METHODS ---
     virtual QRectF boundingRect() const;
-    virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *);
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) override final;
+    virtual void draw(QPainter *painter);
+
+    void onCollide(Entity* other, qint64 deltaTime);
 
     // Abstract methods
-    virtual void onCollide(Entity* other, qint64 deltaTime) = 0;
     virtual bool onUpdate(qint64 deltaTime) = 0;
     virtual Entity* getSpawned() = 0;
 };
@@ -0,0 +1,31 @@
+#ifndef ENTITYKINDS_HPP
+#define ENTITYKINDS_HPP
+
+namespace EntityKinds {
+    enum EntityKind {
+        None,
+        Player,
+        Mob,
+        RangedMob,
+        Missile,
+        Rocket,
+        EffectZone,
+        Item,
+        Count       // Amount of kinds, not a kind
+    };
+
+    /**
+     * Get the display name of a kind
+     *
+     * @param kind The kind
+     * @return Name of the kind
+     */
+    inline const char* getName(EntityKind kind) {
+        static constexpr const char* names[Count] = {
+            "none", "player", "mob", "ranged_mob", "missile", "rocket", "effect_zone", "item"
+        };
+        return kind >= 0 && kind < Count ? names[kind] : "";
+    }
+}
+
+#endif   // ENTITYKINDS_HPP
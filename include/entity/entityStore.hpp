@@ -0,0 +1,179 @@
+#ifndef ENTITYSTORE_HPP
+#define ENTITYSTORE_HPP
+
+#include <QtGlobal>
+#include <QList>
+#include "../vector2.hpp"
+#include "effect.hpp"
+#include "teams.hpp"
+#include "entityKinds.hpp"
+
+class Entity;
+class MainScene;
+
+// Components of a living entity
+struct Health {
+    qreal life = 0;
+    qreal maxLife = 0;
+    bool dead = false;
+};
+
+struct StatusEffects {
+    Effect burning;
+    Effect poisoned;
+    Effect frozen;
+};
+
+// What the collision broad-phase and dispatch look at
+struct CollisionShape {
+    EntityKinds::EntityKind kind = EntityKinds::None;
+    quint32 layer = 0;      // Layer this entity belongs to, see CollisionLayers
+    quint32 mask = 0;       // Layers this entity reacts to
+};
+
+// Straight-line motion of missiles, run by EntityStore::moveMissiles()
+struct Flight {
+    bool enabled = false;   // Only missiles fly
+    qreal range = 0;        // Distance left to travel before despawn. Negative once over.
+};
+
+// Data of every entity, one contiguous array per component.
+// Entities only keep the index of their row and read/write their state through it,
+// so that systems can walk plain arrays instead of chasing Entity pointers.
+// Rows stay packed: removing an entity moves the last row in its place.
+// Rows of entities living in a scene come first, in [0; getActiveCount()[, so that systems
+// skip entities kept aside as templates (spawn caches, loot caches).
+//
+// The store is global: only one MainScene may exist at a time (see attachScene()), and
+// entities may only be created, deleted or added to the scene on the main thread, which
+// resizes and reorders the arrays. Both are asserted in debug builds.
+// During the parallel update, workers write the rows of the entities they update through
+// the accessors below; nothing else may run on the store meanwhile.
+class EntityStore {
+    friend class Entity;
+
+private:
+    // Components, indexed by row
+    static QList<Entity*> owners;
+    static QList<Vector2> positions;
+    static QList<Vector2> previousPositions;    // Position at the start of current tick, used for render interpolation
+    static QList<Vector2> dimensions;
+    static QList<Vector2> velocities;
+    static QList<Health> healths;
+    static QList<StatusEffects> effects;
+    static QList<Teams::Team> teams;
+    static QList<CollisionShape> shapes;
+    static QList<Flight> flights;
+
+    static qsizetype activeCount;
+    static const MainScene* scene;      // Scene owning the active rows
+
+    EntityStore();
+    ~EntityStore();
+
+    static qsizetype add(Entity* owner);
+    static void remove(qsizetype row);
+    static void moveRow(qsizetype from, qsizetype to);
+    static void swapRows(qsizetype first, qsizetype second);
+    static bool isMainThread();
+
+public:
+    static qsizetype getCount();
+    static qsizetype getActiveCount();
+    static void activate(const Entity* entity);
+    static void attachScene(const MainScene* newScene);
+    static void detachScene(const MainScene* oldScene);
+
+    // Systems, run on active rows
+    static void snapshotPositions();
+    static void interpolateRender(qreal alpha);
+    static qsizetype moveMissiles(qsizetype from, qint64 deltaTime);
+
+    /**
+     * Get position component of a row
+     *
+     * @param row Row of the entity
+     * @return Position of the entity
+     */
+    static Vector2& position(qsizetype row) { return positions[row]; }
+
+    /**
+     * Get previous position component of a row
+     *
+     * @param row Row of the entity
+     * @return Position of the entity at the start of the tick
+     */
+    static Vector2& previousPosition(qsizetype row) { return previousPositions[row]; }
+
+    /**
+     * Get dimensions component of a row
+     *
+     * @param row Row of the entity
+     * @return Dimensions of the entity
+     */
+    static Vector2& dimension(qsizetype row) { return dimensions[row]; }
+
+    /**
+     * Get velocity component of a row
+     *
+     * @param row Row of the entity
+     * @return Velocity of the entity
+     */
+    static Vector2& velocity(qsizetype row) { return velocities[row]; }
+
+    /**
+     * Get health component of a row
+     *
+     * @param row Row of the entity
+     * @return Health of the entity
+     */
+    static Health& health(qsizetype row) { return healths[row]; }
+
+    /**
+     * Get status effects component of a row
+     *
+     * @param row Row of the entity
+     * @return Status effects of the entity
+     */
+    static StatusEffects& effect(qsizetype row) { return effects[row]; }
+
+    /**
+     * Get team component of a row
+     *
+     * @param row Row of the entity
+     * @return Team of the entity
+     */
+    static Teams::Team& team(qsizetype row) { return teams[row]; }
+
+    /**
+     * Get collision shape component of a row
+     *
+     * @param row Row of the entity
+     * @return Collision shape of the entity
+     */
+    static CollisionShape& shape(qsizetype row) { return shapes[row]; }
+
+    /**
+     * Get flight component of a row
+     *
+     * @param row Row of the entity
+     * @return Flight of the entity, disabled if it is not a missile
+     */
+    static Flight& flight(qsizetype row) { return flights[row]; }
+};
+
+// Initialize static variables
+inline QList<Entity*> EntityStore::owners;
+inline QList<Vector2> EntityStore::positions;
+inline QList<Vector2> EntityStore::previousPositions;
+inline QList<Vector2> EntityStore::dimensions;
+inline QList<Vector2> EntityStore::velocities;
+inline QList<Health> EntityStore::healths;
+inline QList<StatusEffects> EntityStore::effects;
+inline QList<Teams::Team> EntityStore::teams;
+inline QList<CollisionShape> EntityStore::shapes;
+inline QList<Flight> EntityStore::flights;
+inline qsizetype EntityStore::activeCount = 0;
+inline const MainScene* EntityStore::scene = nullptr;
+
+#endif   // ENTITYSTORE_HPP
@@ -22,8 +22,7 @@ namespace ItemType {
 class Item : public Entity {
 private:
     const qreal nameVerticalSpace = 17;
-    static QMap<QString, Item*>* itemsCache;
-    static inline unsigned int itemsCount = 0;
+    static QMap<QString, Item*>* itemsCache;     // Kept until AssetManager::clear()
 
     bool isInCache = false;
     bool showName = false;
@@ -51,11 +50,18 @@ public:
     ~Item();
     static Item* create(const QString& itemName, Vector2 position);
 
+    // Pooled allocation
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
+    // Collision handlers, called by CollisionDispatch
+    void touchPlayer();
+
     // Inherited methods
-    void onCollide(Entity* other, qint64 deltaTime) override;
+    EntityKinds::EntityKind getKind() const override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
-    void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) override;
+    void draw(QPainter *painter) override;
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
 
@@ -8,19 +8,13 @@
 // Abstract class
 class LivingEntity : public Entity {
 private:
-    Effect burning;
-    Effect poisoned;
-    Effect frozen;
-
+    // Life and effects are components of EntityStore
     qreal speed;
     bool isLookingLeft = false;
 
     void initEffects();
 
 protected:
-    qreal life;
-    qreal maxLife;
-    bool isDead;
     const qint64 burningTime = 3000;
     const qint64 poisonedTime = 10000;
     
@@ -48,8 +42,9 @@ public:
     void setSpeed(const qreal speed);
 
     // Virtual methods
-    virtual void onDeath() = 0;
+    virtual void onDeath() = 0;       // May run on a worker thread: must not create entities, ask for them through getSpawned()
     virtual bool onUpdate(qint64 deltaTime);
+    void draw(QPainter *painter) override;
 
     // Methods
     void giveEffect(const Effect& effect);
@@ -4,15 +4,22 @@
 #include "../vector2.hpp"
 #include "entity.hpp"
 
+class LivingEntity;
+
 class Missile : public Entity {
 protected:
-    Vector2 velocity;
-    qreal lifetime;    // Distance left to travel before despawn
     qreal damage;
     bool pierceEntities;
 
+    // Heading is fixed after launch: rotation and rotated geometry are computed when velocity is set
+    qreal heading = 0;              // Clockwise rotation of the sprite, in degrees
+    QRectF rotatedBounds;           // Result of boundingRect()
+    QPainterPath rotatedShape;      // Result of shape()
+
     Missile(const Missile& other);
     QTransform getRotationTF(QPointF rectCenter) const;
+    void updateRotation();
+    bool isRangeOver() const;
 
 public:
     // Constructor/destructor
@@ -22,17 +29,25 @@ public:
 
     virtual Missile* copy() const;
 
+    // Pooled allocation
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     // Getters
     Vector2 getSpeed() const;
 
     // Setters
     void setSpeed(const Vector2 speed);
 
+    // Collision handlers, called by CollisionDispatch
+    void hitLivingEntity(LivingEntity* entity, qint64 deltaTime);
+
     // Inherited methods
-    void onCollide(Entity* other, qint64 deltaTime) override;
+    EntityKinds::EntityKind getKind() const override;
+    bool canUpdateInParallel() const override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
-    void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) override;
+    void draw(QPainter *painter) override;
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
 
@@ -14,7 +14,8 @@ protected:
     QString lootTable;
     qint64 scoreValue;
 
-    Item* loot = nullptr;
+    bool lootPending = false;   // Loot is rolled by getSpawned(), on the main thread
+    bool moveDone = false;      // Already moved this tick by MobSteering
 
 public:
     // Constructors/destructors
@@ -26,16 +27,21 @@ public:
 
     virtual Mob* copy() const;
 
+    // Collision handlers, called by CollisionDispatch
+    void collideWithPlayer(Player* player);
+
     // Inherited methods
+    EntityKinds::EntityKind getKind() const override;
+    bool canUpdateInParallel() const override;
     void onDeath() override;
-    void onCollide(Entity* other, qint64 deltaTime) override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
 
     qreal getDamage() const;
     Item* getRandomLoot() const;
     bool getDeleted() const override;
-    qint64 getScoreValue() const;
+    qint64 getScoreValue() const override;
+    Player* getTarget() const;
     void setTarget(Player* newTarget);
     void setLootTable(const QString& lootTable);
     void setScoreValue(const qint64 value);
@@ -46,6 +52,8 @@ public:
     static void loadAllMobs(QMap<QString, Mob*>* mobs);
 
     void moveTowardTarget(qint64 deltaTime);
+    qreal getStepLength(qint64 deltaTime) const;
+    void skipNextMove();
 };
 
 #endif   // MOB_HPP
\ No newline at end of file
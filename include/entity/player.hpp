@@ -5,6 +5,7 @@
 #include <QGraphicsSceneMouseEvent>
 #include "livingEntity.hpp"
 #include "item.hpp"
+#include "playerAction.hpp"
 #include "../weapon/weapon.hpp"
 
 namespace Inventory {
@@ -14,6 +15,8 @@ namespace Inventory {
     };
 }
 
+class Mob;
+
 class Player : public LivingEntity {
 private:
     qreal leftKeyPressed = 0;
@@ -65,13 +68,17 @@ public:
     void setMaxEnergy(const qint64 newMaxEnergy);
     void addGold(const qint64 amount);
 
+    // Collision handlers, called by CollisionDispatch
+    void collideWithItem(Item* item);
+    void collideWithMob(Mob* mob, qint64 deltaTime);
+
     // Inherited methods
+    EntityKinds::EntityKind getKind() const override;
     void onDeath() override;
-    void onCollide(Entity* other, qint64 deltaTime) override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
     QRectF boundingRect() const override;
-    void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) override;
+    void draw(QPainter *painter) override;
     QPainterPath shape() const override;
 
     // Player actions. Actions are reactions to input events
@@ -84,6 +91,7 @@ public:
     void actionSetUsingWeapon(const bool isUsingWeapon);
     void actionSetTargetDirection(const Vector2 direction);
     void actionChangeWeapon();
+    void applyAction(const PlayerAction& action);
 };
 
 #endif   // PLAYER_HPP
\ No newline at end of file
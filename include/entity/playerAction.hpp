@@ -0,0 +1,27 @@
+#ifndef PLAYERACTION_HPP
+#define PLAYERACTION_HPP
+
+#include <QtGlobal>
+
+namespace PlayerActions {
+    enum PlayerActionType : quint8 {
+        LeftMovement,
+        RightMovement,
+        UpMovement,
+        DownMovement,
+        GrabPress,
+        UsingWeapon,
+        TargetDirection,
+        ChangeWeapon
+    };
+}
+
+// Reaction of the player to an input event, independent from the event itself.
+// Movements and presses use x only, target direction uses x and y.
+struct PlayerAction {
+    PlayerActions::PlayerActionType type;
+    qreal x = 0;
+    qreal y = 0;
+};
+
+#endif   // PLAYERACTION_HPP
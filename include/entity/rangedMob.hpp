@@ -13,7 +13,9 @@ protected:
     qreal maxShootingDistance;
 
     Missile* bulletCache;     // Easy bullet copy from this instance
-    Missile* bulletSpawn = nullptr;     // Store a bullet to shoot soon
+    bool shotPending = false;   // A bullet should be created by getSpawned(), on the main thread
+    Vector2 shotOrigin;         // Center of the pending bullet
+    Vector2 shotVelocity;       // Velocity of the pending bullet
     qint64 delay = 0;
     bool shootStateActive = false;
     
@@ -27,6 +29,7 @@ public:
     Mob* copy() const override;
 
     // Inherited methods
+    EntityKinds::EntityKind getKind() const override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
 
@@ -20,11 +20,18 @@ public:
 
     Missile* copy() const override;
 
+    // Pooled allocation
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     // Methods
     void explode();
 
+    // Collision handlers, called by CollisionDispatch
+    void hitLivingEntity(LivingEntity* entity, qint64 deltaTime);
+
     // Inherited methods
-    void onCollide(Entity* other, qint64 deltaTime) override;
+    EntityKinds::EntityKind getKind() const override;
     bool onUpdate(qint64 deltaTime) override;
     Entity* getSpawned() override;
 };
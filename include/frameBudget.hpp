@@ -0,0 +1,41 @@
+#ifndef FRAMEBUDGET_HPP
+#define FRAMEBUDGET_HPP
+
+#include <ostream>
+#include <QtGlobal>
+#include <QString>
+
+// Measured cost of a headless run
+struct RunMetrics {
+    qreal meanTickMs = 0;
+    qreal p99TickMs = 0;
+    qreal allocationsPerTick = 0;   // Calls to the global operator new per tick
+    qreal entityThroughput = 0;     // Entity updates per wall-clock second
+    qreal referenceMs = 0;          // Duration of the reference workload on this machine, see FrameBudget::measureReference()
+};
+
+// Stored baseline of a fixed, seeded scenario.
+// A later run of the same scenario fails the check when it is slower than the baseline
+// by more than the tolerance, so that regressions show up before they ship.
+// Times are stored relative to a reference workload timed in the same process, so that a
+// baseline recorded on one machine can be checked on another one (bench/budgets, CTest).
+struct FrameBudget {
+    static constexpr qreal DefaultTolerance = 0.25;
+    static constexpr int NotRecordedExitCode = 77;     // Exit code of a check whose baseline was never recorded: skipped by CTest
+
+    QString spawnerFilename;
+    quint64 seed = 0;
+    qint64 ticks = 0;
+    qint64 tickDuration = 0;
+    qreal tolerance = DefaultTolerance;     // Allowed relative slowdown
+    bool measured = false;                  // False for a scenario whose baseline was never recorded
+    RunMetrics baseline;
+
+    static qreal measureReference();
+
+    bool load(const QString& filename);
+    bool save(const QString& filename) const;
+    bool check(const RunMetrics& metrics, std::ostream& out) const;
+};
+
+#endif   // FRAMEBUDGET_HPP
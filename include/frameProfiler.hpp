@@ -0,0 +1,87 @@
+#ifndef FRAMEPROFILER_HPP
+#define FRAMEPROFILER_HPP
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QString>
+
+namespace ProfilePhases {
+    enum Phase {
+        Collisions,
+        Update,
+        Cleanup,
+        Spawn,
+        Step,       // Whole simulation tick
+        Render,     // Paint of the view
+        Count       // Amount of phases, not a phase
+    };
+
+    const char* getName(Phase phase);
+}
+
+// Rolling log-scale histogram of durations: keeps the last WindowSize samples
+class PhaseHistogram {
+public:
+    static constexpr int BucketsPerDoubling = 4;
+    static constexpr int BucketCount = 25*BucketsPerDoubling;     // 1 µs to ~30 s
+    static constexpr qsizetype WindowSize = 600;                  // 10 s of ticks at 60 Hz
+
+private:
+    quint32 counts[BucketCount] = {};
+    quint8 window[WindowSize] = {};     // Bucket of each sample of the window, oldest overwritten first
+    qsizetype windowPos = 0;
+    qsizetype windowFill = 0;
+
+    static int bucketOf(qint64 ns);
+    static qreal bucketValue(int bucket);
+
+public:
+    void add(qint64 ns);
+    qreal percentile(qreal p) const;
+    qsizetype getSampleCount() const;
+};
+
+// Collects the duration of each phase of the game loop
+class FrameProfiler {
+private:
+    PhaseHistogram histograms[ProfilePhases::Count];
+    qint64 frameTotals[ProfilePhases::Count] = {};      // Time spent in each phase since last endFrame()
+    qint64 frameIndex = 0;
+    qsizetype lastEntityCount = 0;
+
+    QFile* csvFile = nullptr;
+    QTextStream* csvStream = nullptr;
+
+public:
+    // Constructor/destructor
+    FrameProfiler();
+    ~FrameProfiler();
+
+    // Getters
+    const PhaseHistogram& getHistogram(ProfilePhases::Phase phase) const;
+    qsizetype getLastEntityCount() const;
+
+    // Methods
+    void addSample(ProfilePhases::Phase phase, qint64 ns);
+    void endFrame(qsizetype entityCount, qint64 sceneTime);
+    bool startCsv(const QString& filename);
+    void stopCsv();
+};
+
+// Times the enclosing scope and gives the result to a profiler. Does nothing without profiler.
+// While tracing is on, the scope is also recorded as a trace span named after the phase.
+class ProfileScope {
+private:
+    FrameProfiler* profiler;
+    ProfilePhases::Phase phase;
+    QElapsedTimer timer;
+    qint64 traceStart = -1;
+
+public:
+    ProfileScope(FrameProfiler* profiler, ProfilePhases::Phase phase);
+    ~ProfileScope();
+};
+
+#endif   // FRAMEPROFILER_HPP
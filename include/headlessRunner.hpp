@@ -0,0 +1,45 @@
+#ifndef HEADLESSRUNNER_HPP
+#define HEADLESSRUNNER_HPP
+
+#include <QtGlobal>
+#include <QString>
+
+struct PoolStats;
+
+// Runs the simulation without any window nor event loop, as fast as the CPU allows
+class HeadlessRunner {
+private:
+    qint64 ticks;
+    qint64 tickDuration;
+    QString spawnerFilename;
+    QString recordFilename;
+    QString replayFilename;
+    QString profileCsvFilename;
+    QString budgetFilename;
+    bool writeBudget = false;
+    bool hasSeed = false;
+    quint64 seed = 0;
+    bool batchSteering = true;
+
+    static void printPoolStats(const char* name, const PoolStats& stats);
+    static qint64 getPeakRss();
+
+public:
+    static constexpr qint64 DefaultTicks = 3600;
+    static constexpr qint64 DefaultTickDuration = 16;
+
+    // Constructor/destructor
+    HeadlessRunner(qint64 ticks = DefaultTicks, qint64 tickDuration = DefaultTickDuration, const QString& spawnerFilename = "");
+    ~HeadlessRunner();
+
+    void setRecordFile(const QString& filename);
+    void setReplayFile(const QString& filename);
+    void setSeed(quint64 newSeed);
+    void setProfileCsvFile(const QString& filename);
+    void setBudgetFile(const QString& filename, bool write);
+    void setBatchSteeringEnabled(bool enabled);
+
+    int run();
+};
+
+#endif   // HEADLESSRUNNER_HPP
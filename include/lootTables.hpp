@@ -4,6 +4,7 @@
 #include <QMap>
 #include <QtGlobal>
 #include <random>
+#include "weapon/weaponRegistry.hpp"
 
 class LootTables {
 private:
@@ -11,8 +12,10 @@ private:
     static QMap<QString, QList<QString>*>* loots;
     // weights["loottable.json"] to get the list of weights, in the same order as loots
     static QMap<QString, std::discrete_distribution<>>* weights;
+    // weaponIds["loottable.json"] to get the weapon of each loot, in the same order as loots.
+    // Resolved when the table is built; InvalidId for loots that are not weapon files.
+    static QMap<QString, QList<WeaponId>*>* weaponIds;
 
-    static std::random_device rd;
     static std::mt19937 mtGen;
 
     LootTables();
@@ -20,18 +23,21 @@ private:
 
     static void addTable(const QString& tableName);
     static void saveDistribution(const QString& tableName, QList<QString>* loots, QList<qreal>* weights);
+    static qsizetype drawIndex(const QString& lootTable);
 
 public:
     static void generateTables();
     static void deleteTables();
     static QString getRandomLoot(const QString& lootTable);
+    static WeaponId getRandomWeapon(const QString& lootTable);
+    static void setSeed(quint32 seed);
 };
 
 // Initialize static variables
 inline QMap<QString, std::discrete_distribution<>>* LootTables::weights = nullptr;
 inline QMap<QString, QList<QString>*>* LootTables::loots = nullptr;
+inline QMap<QString, QList<WeaponId>*>* LootTables::weaponIds = nullptr;
 
-inline std::random_device LootTables::rd = std::random_device();
-inline std::mt19937 LootTables::mtGen = std::mt19937(LootTables::rd());
+inline std::mt19937 LootTables::mtGen = std::mt19937(std::random_device()());
 
 #endif   // LOOTTABLES_HPP
\ No newline at end of file
@@ -5,17 +5,32 @@
 #include <QWidget>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QKeyEvent>
+#include <QPaintEvent>
 #include "mainScene.hpp"
 
 class MainGraphicsView : public QGraphicsView {
+private:
+    MainScene* mainScene;
+    bool showProfiler = false;      // Draw the frame profiler overlay (toggled with F3)
+
+    static constexpr int ProfilerOverlayWidth = 260;
+    static constexpr int CostOverlayWidth = 460;    // Overlay is wider while it shows entity costs
+
 public:
     MainGraphicsView(MainScene* scene, QWidget* parent = nullptr);
     ~MainGraphicsView();
     void mouseMoveEvent(QMouseEvent* event) override;
     void centerOnPlayer(Player* player);
+    bool isProfilerShown() const;
+    void setProfilerShown(bool show);
 protected:
     void wheelEvent(QWheelEvent *event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
 private:
+    QRect profilerOverlayRect() const;
 };
 
 #endif   // MAINGRAPHICSVIEW_HPP
\ No newline at end of file
@@ -7,23 +7,62 @@
 #include <QObject>
 #include <QString>
 #include <QPixmap>
+#include <QPair>
 #include "entity/entity.hpp"
 #include "entity/player.hpp"
 #include "mobSpawner.hpp"
+#include "spatialHash.hpp"
+#include "sessionRecorder.hpp"
+#include "sessionReplay.hpp"
+#include "frameProfiler.hpp"
+#include "mobSteering.hpp"
 
 class MainScene : public QGraphicsScene {
     Q_OBJECT  // This macro should be the first thing inside the class definition
 
 private:
+    // Emitted when an entity leaves the scene
+    struct DeathEvent {
+        qint64 scoreValue;
+    };
+
     QList<Entity*>* entities;
+    QList<DeathEvent> deathEvents;      // Deaths of current tick, reused every tick
+
+    // Slice of the parallel update batch, processed by one worker
+    struct UpdateChunk {
+        qsizetype begin;
+        qsizetype end;
+        QList<Entity*> spawners;    // Command buffer: entities of the chunk asking to spawn
+    };
+
+    QList<Entity*> serialBatch;     // Entities updated on the main thread, reused every tick
+    QList<Entity*> parallelBatch;   // Independent entities, updated after the serial batch (by the thread pool if enabled)
+    QList<UpdateChunk> updateChunks;
+    QList<Entity*> spawners;        // Merged command buffers, applied on the main thread
+    bool useParallelUpdate = true;
+    MobSteering* mobSteering;       // Moves chasing mobs of the parallel batch in one pass
+    bool useBatchSteering = true;
+    qsizetype movedMissileRows = 0;     // Active rows of EntityStore already moved this tick, see EntityStore::moveMissiles()
+    SpatialHash* spatialHash;       // Collision broad-phase
+    FrameProfiler* profiler;        // Times each phase of step()
+    bool framePending = false;      // Frame simulated but not closed yet: it waits for the paint of the view
+    QList<QPair<Entity*, Entity*>> collisionPairs;     // Candidate pairs, reused every frame
+    bool useSpatialHash = true;
     QElapsedTimer deltaTimer;
     qint64 lastFrameTime;
 
-    QTimer* gameTimer;
-    qint64 deltaTime;   // Time between two frames
+    QTimer* gameTimer = nullptr;
+    bool headless;      // Headless scenes have no timer and keep entities out of the QGraphicsScene
+    qint64 deltaTime;   // Simulated time of the current tick
+    qint64 tickAccumulator = 0;     // Wall-clock time not simulated yet
     qint64 sceneTime;   // Time passed since start of scene
     Player* mainPlayer = nullptr;
     MobSpawner* mobSpawner = nullptr;
+    QString spawnerFilename;
+    quint64 seed = 0;       // Seed of every random generator of the simulation
+    SessionRecorder* recorder = nullptr;
+    SessionReplay* replay = nullptr;
     QPixmap m_tileImage;
     qint64 gameScore = 0;   // Total score of the game
 
@@ -31,10 +70,17 @@ protected:
     void addEntity(Entity* entity);
     void setControlledPlayer(Player* player);
     void checkCollisions();
+    void checkCollisionsLinear();
     void updateEntities();
+    void updateRange(qsizetype begin, qsizetype end);
+    void updateParallelBatch();
+    void updateSlice(const QList<Entity*>& batch, qsizetype begin, qsizetype end, QList<Entity*>* spawned);
     void cleanupScene();
+    void processDeathEvents();
     void spawnMobWave();
+    void interpolateEntities(qreal alpha);
     void gameLoop();
+    void applyPlayerAction(const PlayerAction& action);
 
     void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
@@ -46,12 +92,39 @@ protected:
 
 public:
     // Constructors/Destructor
-    MainScene(QObject* parent = nullptr, int fps=60);
+    MainScene(QObject* parent = nullptr, int fps=60, bool headless=false);
     virtual ~MainScene();
     Player* getMainPlayer();
-    void setBackgroundTile(const QString &image_path);
+    qsizetype getEntityCount() const;
+    qint64 getScore() const;
+    qint64 getSceneTime() const;
+    FrameProfiler* getProfiler() const;
+    void endFrame();
+    quint64 getStateChecksum() const;
+    bool isHeadless() const;
+
+    static constexpr qint64 TickDuration = 16;      // Fixed simulation tick (~60 Hz), in milliseconds
+    static constexpr int MaxTicksPerFrame = 5;      // Avoids spiraling down after a long frame
+
+    void step(qint64 deltaMs = TickDuration);
+    void setBackgroundTile(const QString& fileName);
 
     void setSpawner(const QString& spawnerFilename);
+    quint64 getSeed() const;
+    void setSeed(quint64 newSeed);
+
+    // Record/replay. Both must start before the first tick.
+    bool startRecording(const QString& filename);
+    void stopRecording();
+    bool startReplay(const QString& filename);
+    bool isReplaying() const;
+    bool isReplayFinished() const;
+    void setCollisionCellSize(qreal cellSize);
+    void setSpatialHashEnabled(bool enabled);
+    void setParallelUpdateEnabled(bool enabled);
+    void setBatchSteeringEnabled(bool enabled);
+
+    static constexpr qsizetype ParallelChunkSize = 256;     // Entities per worker task
 signals:
     void playerMoved(Player* player);
 };
@@ -9,10 +9,12 @@
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLineEdit>
+#include <QProgressBar>
 #include <QTimer>
 #include <QScreen>
 #include "../mainScene.hpp"
 #include "../mainGraphicsView.hpp"
+#include "../assetPreloader.hpp"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -23,14 +25,24 @@ public:
     void centerOnSelectedPlayer(MainGraphicsView* view, MainScene* scene);
     QString* getHeroName();
     void setHeroName(QString* name);
+    void setSessionFiles(const QString& recordFile, const QString& replayFile);
+    void setProfiling(const QString& csvFile, bool overlay);
 private:
+    void startGame();
+
     QLineEdit* pseudoInput = nullptr;
     QPushButton* newGame = nullptr;
     QPushButton* quitGame = nullptr;
     QPushButton* scoreBoard = nullptr;
+    QProgressBar* loadingBar = nullptr;     // Shown while assets are preloaded
+    AssetPreloader* preloader = nullptr;
     MainScene* scene = nullptr;
     MainGraphicsView* view = nullptr;
     QString* heroName = nullptr;
+    QString recordFilename;     // Session file to record new games to, if any
+    QString replayFilename;     // Session file to replay instead of playing, if any
+    QString profileCsvFilename; // File to write per-frame phase timings to, if any
+    bool profileOverlay = false;
 };
 
 #endif
\ No newline at end of file
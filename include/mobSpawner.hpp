@@ -8,6 +8,7 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QRandomGenerator>
 #include "entity/mob.hpp"
 
 
@@ -26,6 +27,7 @@ private:
     qreal spawnRange = 0;
     qint64 allWavesDuration = 0;
     qint64 substractSceneTime = 0;
+    QRandomGenerator random;        // Spawn angles. Seeded, so that sessions can be replayed
 
     void createMobsCache();
     void createSpawnCache(const QString& filename);
@@ -37,6 +39,7 @@ public:
     MobSpawner(const QString& filename);
     ~MobSpawner();
 
+    void setSeed(quint32 seed);
     Mob* getSpawned(qint64 sceneTime, Player* target = nullptr);
 };
 
@@ -0,0 +1,26 @@
+#ifndef MOBSTEERING_HPP
+#define MOBSTEERING_HPP
+
+#include <QtGlobal>
+#include <QList>
+#include "vector2.hpp"
+
+class Entity;
+class Mob;
+
+// Moves every chasing mob toward its target in one pass.
+// Positions, directions and step lengths are gathered in flat arrays, moved with the
+// Vector2Batch kernels, then written back. Results are the same as Mob::moveTowardTarget().
+class MobSteering {
+private:
+    // Buffers reused every tick
+    QList<Mob*> mobs;
+    QList<Vector2> positions;
+    QList<Vector2> directions;
+    QList<qreal> stepLengths;
+
+public:
+    void steer(const QList<Entity*>& entities, qint64 deltaTime);
+};
+
+#endif   // MOBSTEERING_HPP
@@ -0,0 +1,108 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <QtGlobal>
+#include <QList>
+
+// Allocation counters of a pool
+struct PoolStats {
+    qint64 allocations = 0;     // Objects handed out since start
+    qint64 deallocations = 0;   // Objects given back since start
+    qint64 slabs = 0;           // Heap allocations done by the pool itself
+    qint64 capacity = 0;        // Slots available across all slabs
+    qint64 live = 0;            // Objects currently allocated
+    qint64 peakLive = 0;
+};
+
+// Fixed-size slab allocator with an intrusive free list, one per type.
+// Classes route their operator new/delete here so that steady-state creation and
+// destruction reuse slots instead of calling malloc/free.
+// Slabs are never given back to the system; the pool only grows up to the peak live count.
+// Not thread-safe: entities must be created and deleted on the simulation thread.
+template <typename T>
+class Pool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr qsizetype SlabSlots = 256;
+
+    static inline Slot* freeList = nullptr;
+    static inline PoolStats stats;
+
+    /**
+     * Allocate a new slab and chain all its slots in the free list
+     */
+    static void grow() {
+        Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * SlabSlots, std::align_val_t(alignof(Slot))));
+        for (qsizetype i=SlabSlots-1; i>=0; i--) {
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+        stats.slabs += 1;
+        stats.capacity += SlabSlots;
+    }
+
+public:
+    /**
+     * Get a slot for a new object.
+     * Requests of another size (derived classes without their own pool) go to the global heap.
+     *
+     * @param size Size of the object to allocate
+     * @return Pointer to uninitialized memory
+     */
+    static void* allocate(std::size_t size) {
+        if (size != sizeof(T)) {
+            return ::operator new(size);
+        }
+
+        if (freeList == nullptr) {
+            grow();
+        }
+        Slot* slot = freeList;
+        freeList = slot->next;
+
+        stats.allocations += 1;
+        stats.live += 1;
+        stats.peakLive = qMax(stats.peakLive, stats.live);
+        return slot;
+    }
+
+    /**
+     * Give a slot back to the pool
+     *
+     * @param ptr Memory returned by allocate()
+     * @param size Size of the destroyed object
+     */
+    static void deallocate(void* ptr, std::size_t size) {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        Slot* slot = static_cast<Slot*>(ptr);
+        slot->next = freeList;
+        freeList = slot;
+
+        stats.deallocations += 1;
+        stats.live -= 1;
+    }
+
+    /**
+     * Get the allocation counters of this pool
+     *
+     * @return Counters of this pool
+     */
+    static PoolStats getStats() {
+        return stats;
+    }
+};
+
+#endif   // POOL_HPP
@@ -0,0 +1,50 @@
+#ifndef SESSIONRECORDER_HPP
+#define SESSIONRECORDER_HPP
+
+#include <QtGlobal>
+#include <QFile>
+#include <QDataStream>
+#include <QString>
+#include "entity/playerAction.hpp"
+
+// Binary layout shared by SessionRecorder and SessionReplay:
+// header (magic, version, seed, spawner), then records in simulation order.
+// Actions are written before the tick they are applied to; consecutive ticks of
+// equal duration are merged in a single record.
+namespace SessionFormat {
+    constexpr quint32 Magic = 0x4D414C4C;      // "MALL"
+    constexpr quint16 Version = 2;         // 2: tick durations on 32 bits (quint16 in version 1)
+    constexpr quint16 MinVersion = 1;      // Oldest version SessionReplay still reads
+
+    enum RecordType : quint8 {
+        Ticks,      // quint32 tick duration, quint32 amount of ticks
+        Action      // quint8 action type, double x, double y
+    };
+}
+
+// Writes the seed, the player actions and the tick durations of a session
+class SessionRecorder {
+private:
+    QFile file;
+    QDataStream stream;
+    qint64 pendingDelta = -1;   // Duration of the ticks not written yet
+    quint32 pendingTicks = 0;
+    qint64 recordedTicks = 0;
+
+    void flushTicks();
+
+public:
+    // Constructor/destructor
+    SessionRecorder(const QString& filename, quint64 seed, const QString& spawnerFilename);
+    ~SessionRecorder();
+
+    bool isOpen() const;
+    qint64 getRecordedTicks() const;
+
+    // Methods
+    void recordAction(const PlayerAction& action);
+    void recordTick(qint64 deltaMs);
+    void close();
+};
+
+#endif   // SESSIONRECORDER_HPP
@@ -0,0 +1,41 @@
+#ifndef SESSIONREPLAY_HPP
+#define SESSIONREPLAY_HPP
+
+#include <QtGlobal>
+#include <QFile>
+#include <QDataStream>
+#include <QString>
+#include "sessionRecorder.hpp"
+
+class Player;
+
+// Reads a session written by SessionRecorder, one tick at a time
+class SessionReplay {
+private:
+    QFile file;
+    QDataStream stream;
+    bool valid = false;
+    bool finished = false;
+    quint16 version = 0;        // Format of the file, see SessionFormat
+    quint64 seed = 0;
+    QString spawnerFilename;
+
+    qint64 currentDelta = 0;
+    quint32 remainingTicks = 0;    // Ticks left in the current record
+
+public:
+    // Constructor/destructor
+    SessionReplay(const QString& filename);
+    ~SessionReplay();
+
+    // Getters
+    bool isValid() const;
+    bool isFinished() const;
+    quint64 getSeed() const;
+    QString getSpawnerFilename() const;
+
+    // Methods
+    qint64 nextTick(Player* player);
+};
+
+#endif   // SESSIONREPLAY_HPP
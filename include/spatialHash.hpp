@@ -0,0 +1,59 @@
+#ifndef SPATIALHASH_HPP
+#define SPATIALHASH_HPP
+
+#include <QtGlobal>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QRectF>
+
+class Entity;
+
+// Uniform grid used as collision broad-phase.
+// Entities are bucketed in every cell their bounding rect overlaps.
+class SpatialHash {
+public:
+    // Cells covered by an entity, bounds included
+    struct CellRange {
+        qint32 minX = 0;
+        qint32 minY = 0;
+        qint32 maxX = -1;
+        qint32 maxY = -1;
+
+        bool operator==(const CellRange& other) const;
+        bool operator!=(const CellRange& other) const;
+    };
+
+    static constexpr qreal DefaultCellSize = 128;
+
+private:
+    qreal cellSize;
+    QHash<quint64, QList<Entity*>> cells;
+    bool deferred = false;      // While true, updates only mark entities as dirty (see setDeferred)
+
+    static quint64 cellKey(qint32 x, qint32 y);
+    CellRange computeRange(const Entity* entity) const;
+    void insertInCells(Entity* entity, const CellRange& range);
+    void removeFromCells(Entity* entity, const CellRange& range);
+
+public:
+    // Constructor/destructor
+    SpatialHash(qreal cellSize = DefaultCellSize);
+    ~SpatialHash();
+
+    // Getters/Setters
+    qreal getCellSize() const;
+    void setCellSize(qreal newCellSize);
+    bool isDeferred() const;
+    void setDeferred(bool defer);
+
+    // Methods
+    void insert(Entity* entity);
+    void update(Entity* entity);
+    void remove(Entity* entity);
+    void clear();
+    void flush(const QList<Entity*>& entities);
+    void findPairs(QList<QPair<Entity*, Entity*>>* pairs) const;
+};
+
+#endif   // SPATIALHASH_HPP
@@ -1,35 +1,73 @@
 #ifndef SPRITE_HPP
 #define SPRITE_HPP
 
+#include <cstddef>
 #include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QCache>
 #include <QSharedPointer>
 #include <QString>
-#include <QMap>
+#include "assetManager.hpp"
+
+// An image of the atlas scaled to a size in device pixels, then mirrored and rotated
+struct ScaledSpriteKey {
+    qint64 page;        // QImage::cacheKey() of the page: stays unique if the page is freed
+    QRect rect;         // Source rect in the page
+    QSize size;         // Device pixels, before rotation
+    qreal pixelRatio;
+    int rotation;       // Degrees, multiple of Sprite::RotationStep
+    bool mirrored;      // Flipped horizontally
+
+    bool operator==(const ScaledSpriteKey& other) const {
+        return page == other.page && rect == other.rect && size == other.size
+            && pixelRatio == other.pixelRatio && rotation == other.rotation && mirrored == other.mirrored;
+    }
+};
+
+inline size_t qHash(const ScaledSpriteKey& key, size_t seed = 0) {
+    return qHashMulti(seed, key.page, key.rect.x(), key.rect.y(), key.size.width(), key.size.height(), key.rotation, key.mirrored);
+}
 
 class Sprite {
 protected:
-    static QMap<QString, QSharedPointer<QImage>>* spritesCache;
-    static inline unsigned int spritesCount = 0;   // Keep track of how much sprites exist
+    static constexpr qint64 DefaultScaledBudget = 32 * 1024 * 1024;     // Bytes of scaled pixmaps
+
+    // Images already scaled to the size they are drawn at, in device format.
+    // LRU limited by scaledBudget: every size, mirror and rotation step is one more pixmap.
+    static inline QCache<ScaledSpriteKey, QPixmap>* scaledCache = nullptr;
+    static inline qint64 scaledBudget = DefaultScaledBudget;
 
-    QSharedPointer<QImage> image;
+    AtlasRegion region;     // Atlas page and rect of the image
 
-    static void initSpritesCache();
+    QPixmap getScaled(const QSize& size, qreal pixelRatio, int rotation, bool mirrored) const;
+    static qint64 getCost(const QPixmap& pixmap);
 
 public:
+    static constexpr int RotationStep = 5;      // Rotated images are cached every RotationStep degrees
+
     // Constructor/destructor
     Sprite();
     Sprite(const QString& fileName);
     Sprite(const Sprite& other);
     ~Sprite();
 
-    QSharedPointer<QImage> getImage() const;
+    // Pooled allocation
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
+    bool isNull() const;
+    QSharedPointer<QImage> getPage() const;
+    QRect getSourceRect() const;
     void setImage(const QString& fileName);
+    void draw(QPainter* painter, const QRectF& target, bool mirrored = false) const;
+    void drawRotated(QPainter* painter, const QRectF& target, qreal angle) const;
 
     static void deleteCachedSprites();
+    static qsizetype getScaledCount();
+    static qint64 getScaledBytes();
+    static void setScaledBudget(qint64 bytes);
+    static qint64 getScaledBudget();
 };
 
-// Default static values
-inline QMap<QString, QSharedPointer<QImage>>* Sprite::spritesCache = nullptr;
-
-
 #endif   // SPRITE_HPP
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef SPRITENAMES_HPP
+#define SPRITENAMES_HPP
+
+#include <QString>
+#include <QStringList>
+
+// Images named in the code rather than in JSON files (res/img).
+// AssetPreloader decodes every name of getAll() ahead of time: use these constants
+// instead of string literals so that a new sprite is not missed by the preloader.
+namespace SpriteNames {
+    inline const QString Player = "player.png";
+    inline const QString Boom = "boom.png";
+    inline const QString FireZone = "fire_zone.png";
+    inline const QString IceZone = "ice_zone.png";
+    inline const QString PoisonZone = "poison_zone.png";
+
+    /**
+     * Get every image named in the code
+     *
+     * @return Names of image files located in res/img
+     */
+    inline QStringList getAll() {
+        return { Player, Boom, FireZone, IceZone, PoisonZone };
+    }
+}
+
+#endif   // SPRITENAMES_HPP
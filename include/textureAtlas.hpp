@@ -0,0 +1,48 @@
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include <QtGlobal>
+#include <QImage>
+#include <QRect>
+#include <QSharedPointer>
+#include <QString>
+#include <QMap>
+#include <QList>
+
+// Part of an atlas page holding one image
+struct AtlasRegion {
+    QSharedPointer<QImage> page;    // nullptr if the image does not exist
+    QRect rect;                     // Where the image is in the page
+};
+
+// Packs every image of res/img into a few large pages, so that sprites drawn one after
+// the other read from the same image instead of jumping between dozens of small ones.
+// Images too big to share a page (backgrounds) are not packed, AssetManager loads them alone.
+class TextureAtlas {
+private:
+    static constexpr int PageSize = 1024;       // Width and height of a shared page
+    static constexpr int MaxPackedSize = 512;   // Bigger images are not packed
+    static constexpr int Padding = 2;           // Transparent pixels between images, avoid bleeding when scaled
+
+    static QMap<QString, AtlasRegion>* regions;    // regions["foo.png"]
+    static QList<QSharedPointer<QImage>>* pages;   // Shared pages
+
+    TextureAtlas();
+    ~TextureAtlas();
+
+public:
+    static void build();
+    static void build(const QMap<QString, QImage>& images);
+    static bool isBuilt();
+    static bool find(const QString& fileName, AtlasRegion* region);
+    static qsizetype getPageCount();
+    static qsizetype getImageCount();
+    static qint64 getBytes();
+    static void clear();
+};
+
+// Initialize static variables
+inline QMap<QString, AtlasRegion>* TextureAtlas::regions = nullptr;
+inline QList<QSharedPointer<QImage>>* TextureAtlas::pages = nullptr;
+
+#endif   // TEXTUREATLAS_HPP
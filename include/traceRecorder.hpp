@@ -0,0 +1,85 @@
+#ifndef TRACERECORDER_HPP
+#define TRACERECORDER_HPP
+
+#include <atomic>
+#include <QtGlobal>
+#include <QString>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+
+// Records spans in the Chrome trace event format (about:tracing, ui.perfetto.dev).
+// Any thread pushes its finished spans into a bounded lock-free ring buffer; a background
+// thread drains it to the trace file. When the buffer is full, spans are dropped, never waited for.
+class TraceRecorder {
+private:
+    // A finished span. Names and categories must be string literals: only the pointer is kept.
+    struct Span {
+        const char* name;
+        const char* category;
+        qint64 start;       // Nanoseconds since start()
+        qint64 duration;    // Nanoseconds
+        quint32 threadId;
+    };
+
+    // Slot of the ring buffer. sequence tells whether the slot is free or holds a span for a given position.
+    struct Slot {
+        std::atomic<quint64> sequence;
+        Span span;
+    };
+
+    static constexpr quint64 Capacity = 1 << 16;   // Must be a power of two
+
+    static Slot* buffer;
+    static std::atomic<quint64> writePos;      // Next position producers claim
+    static quint64 readPos;                    // Next position the writer thread reads (writer only)
+    static std::atomic<bool> enabled;
+    static std::atomic<bool> running;
+    static std::atomic<qint64> dropped;
+    static std::atomic<quint32> threadCount;
+    static quint32 mainThreadId;
+    static QElapsedTimer clock;
+    static QFile* file;
+    static QThread* writer;
+
+    TraceRecorder();
+    ~TraceRecorder();
+
+    static quint32 currentThreadId();
+    static bool pop(Span* span);
+    static void writeLoop();
+
+public:
+    static bool start(const QString& filename);
+    static void stop();
+    static bool isEnabled();
+    static qint64 now();
+    static void addSpan(const char* name, const char* category, qint64 start, qint64 end);
+};
+
+// Initialize static variables
+inline TraceRecorder::Slot* TraceRecorder::buffer = nullptr;
+inline std::atomic<quint64> TraceRecorder::writePos = 0;
+inline quint64 TraceRecorder::readPos = 0;
+inline std::atomic<bool> TraceRecorder::enabled = false;
+inline std::atomic<bool> TraceRecorder::running = false;
+inline std::atomic<qint64> TraceRecorder::dropped = 0;
+inline std::atomic<quint32> TraceRecorder::threadCount = 0;
+inline quint32 TraceRecorder::mainThreadId = 0;
+inline QElapsedTimer TraceRecorder::clock;
+inline QFile* TraceRecorder::file = nullptr;
+inline QThread* TraceRecorder::writer = nullptr;
+
+// Records the enclosing scope as a span. Costs a single atomic load while tracing is off.
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    qint64 start;       // -1 when tracing was off at construction
+
+public:
+    TraceSpan(const char* name, const char* category);
+    ~TraceSpan();
+};
+
+#endif   // TRACERECORDER_HPP
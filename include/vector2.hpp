@@ -1,11 +1,18 @@
 #ifndef VECTOR2_HPP
 #define VECTOR2_HPP
 
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <type_traits>
 #include <QtGlobal>
 #include <QPointF>
 
-// Vector2 is immutable
+#define VECTOR2_EPSILON 0.0000001
+
+// Vector2 is immutable.
+// Header-only and trivially copyable, so that every operation inlines in the caller
+// and arrays of Vector2 are plain arrays of (x, y) pairs (see Vector2Batch).
 class Vector2 {
 private:
     qreal x=0;
@@ -19,49 +26,273 @@ public:
     static const Vector2 left;
     static const Vector2 right;
 
-    // Constructors
-    Vector2();
-    Vector2(qreal x, qreal y);
-    Vector2(const QPointF point);
-    Vector2(const Vector2& other);
-
-    // Destructor
-    ~Vector2();
-
-    // Getters
-    qreal getX() const;
-    qreal getY() const;
-
-    // Operators
-    Vector2 operator+(const Vector2& other) const;
-    Vector2 operator-(const Vector2& other) const;
-    Vector2 operator*(qreal scalar) const;
-    Vector2 operator/(qreal scalar) const;
-
-    // Operation on magnitude
-    qreal magnitude() const;
-    qreal sqrMagnitude() const;
-    Vector2 normalized() const;
-
-    // Dot product / Vector product
-    qreal dot(const Vector2& other) const;
-    qreal cross(const Vector2& other) const;
-
-    // Comparisons
-    bool operator==(const Vector2& other) const;
-    bool operator!=(const Vector2& other) const;
-
-    friend std::ostream& operator<<(std::ostream& os, const Vector2& v);    // From chatGPT
-
-    // Other
-    Vector2 rotate(qreal angle) const;
-    qreal angleWith(const Vector2 other) const;
-    Vector2 projectOnto(const Vector2& other) const;
-    Vector2 minimum(const Vector2 other) const;
-    Vector2 maximum(const Vector2 other) const;
-    qreal distanceWith(const Vector2 other) const;
-    QPointF toPointF() const;
+    // --- Constructors ---
+
+    /**
+     * Default constructor
+     */
+    constexpr Vector2() = default;
+
+    /**
+     * Constructor
+     *
+     * @param x, y Coordinates of vector
+     */
+    constexpr Vector2(qreal x, qreal y) : x(x), y(y) {}
+
+    /**
+     * Constructor
+     *
+     * @param point Point to convert vector from
+     */
+    constexpr Vector2(const QPointF point) : x(point.x()), y(point.y()) {}
+
+    // --- Getters ---
+
+    /**
+     * Get abscissa of vector
+     *
+     * @return abscissa of the vector
+     */
+    constexpr qreal getX() const {
+        return x;
+    }
+
+    /**
+     * Get ordinate of vector
+     *
+     * @return ordinate of the vector
+     */
+    constexpr qreal getY() const {
+        return y;
+    }
+
+    // --- Operators ---
+
+    /**
+     * Sum this vector with another
+     *
+     * @param other The other vector
+     * @return sum of the two vectors
+     */
+    constexpr Vector2 operator+(const Vector2& other) const {
+        return Vector2(x + other.x, y + other.y);
+    }
+
+    /**
+     * Substract this vector with another
+     *
+     * @param other The other vector
+     * @return This vector minus the other
+     */
+    constexpr Vector2 operator-(const Vector2& other) const {
+        return Vector2(x - other.x, y - other.y);
+    }
+
+    /**
+     * Multiplies this vector with a scalar
+     *
+     * @param scalar Scalar to multiply this vector with
+     * @return This vector multiplied with the scalar
+     */
+    constexpr Vector2 operator*(qreal scalar) const {
+        return Vector2(x * scalar, y * scalar);
+    }
+
+    /**
+     * Divides this vector with a scalar
+     *
+     * @param scalar Scalar to divide this vector with
+     * @return This vector divided with the scalar. Throws an error if scalar is zero
+     */
+    constexpr Vector2 operator/(qreal scalar) const {
+        if (scalar == 0) {
+            throw std::runtime_error("Erreur : Division par zéro !");
+        }
+        return Vector2(x/scalar, y/scalar);
+    }
+
+    // --- Operations on magnitude ---
+
+    /**
+     * Get the magnitude of this vector
+     *
+     * @return magnitude of this vector
+     */
+    qreal magnitude() const {
+        return std::sqrt(x*x + y*y);
+    }
+
+    /**
+     * Get the squared magnitude of this vector (useful for optimizations)
+     *
+     * @return squared magnitude of this vector
+     */
+    constexpr qreal sqrMagnitude() const {
+        return x*x + y*y;
+    }
+
+    /**
+     * Normalize a vector
+     *
+     * @return this vector, normalized
+     */
+    Vector2 normalized() const {
+        qreal mag = magnitude();
+        if (mag == 0) {
+            // If magnitude is zero, keep vector as it was before
+            return *this;
+        }
+        else {
+            return *this / mag;
+        }
+    }
 
+    // --- Dot product / Vector product ---
+
+    /**
+     * Dot product between this vector and another
+     *
+     * @param other Another vector
+     * @return dot product of this vector and the other
+     */
+    constexpr qreal dot(const Vector2& other) const {
+        return x * other.x + y * other.y;
+    }
+
+    /**
+     * 2D version of cross product
+     *
+     * @param other Another vector
+     * @return 2D "cross product"
+     */
+    constexpr qreal cross(const Vector2& other) const {
+        return x * other.y - y * other.x;
+    }
+
+    // --- Comparisons ---
+
+    /**
+     * Compare this vector and another
+     *
+     * @param other Another vector
+     * @return whether this vector is equal to the other or not
+     */
+    bool operator==(const Vector2& other) const {
+        return std::abs(x - other.x) < VECTOR2_EPSILON && std::abs(y - other.y);
+    }
+
+    /**
+     * Compare this vector and another
+     *
+     * @param other Another vector
+     * @return whether this vector is different to the other or not
+     */
+    bool operator!=(const Vector2& other) const {
+        return std::abs(x - other.x) > VECTOR2_EPSILON || std::abs(y - other.y) > VECTOR2_EPSILON;
+    }
+
+    /**
+     * << operator override
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Vector2& v) {       // From ChatGPT
+        os << "(" << v.x << ", " << v.y << ")";
+        return os;
+    }
+
+    // --- Other ---
+
+    /**
+     * Rotate this vector with given angle
+     *
+     * @param angle Angle to rotate this vector with
+     * @return Rotated vector
+     */
+    Vector2 rotate(qreal angle) const {
+        qreal rad = angle * (M_PI / 180.0);        // Convert angle to rad
+        qreal cosAngle = std::cos(rad);
+        qreal sinAngle = std::sin(rad);
+        return Vector2(x * cosAngle - y * sinAngle, x * sinAngle + y * cosAngle);
+    }
+
+    /**
+     * Calculate the angle of this vector with another in degrees
+     *
+     * @param other the other vector
+     * @return the angle between the two vectors (degrees)
+     */
+    qreal angleWith(const Vector2 other) const {
+        qreal sign = this->cross(other) > 0 ? 1 : -1;
+        return sign * std::acos(this->dot(other) / (this->magnitude() / other.magnitude())) * 180 / M_PI;
+    }
+
+    /**
+     * Project this vector on another vector
+     *
+     * @param other Another vector
+     * @return Projected vector
+     */
+    constexpr Vector2 projectOnto(const Vector2& other) const {
+        qreal scalar = dot(other) / other.sqrMagnitude();
+        return other * scalar;
+    }
+
+    /**
+     * Get a new vector, taking minimum values on each coordinate
+     *
+     * @param other Another vector
+     * @return The minimum coordinates between this and the other vector
+     */
+    constexpr Vector2 minimum(const Vector2 other) const {
+        return Vector2(
+            x < other.x ? x : other.x,
+            y < other.y ? y : other.y
+        );
+    }
+
+    /**
+     * Get a new vector, taking maximum values on each coordinate
+     *
+     * @param other Another vector
+     * @return The maximum coordinates between this and the other vector
+     */
+    constexpr Vector2 maximum(const Vector2 other) const {
+        return Vector2(
+            x < other.x ? other.x : x,
+            y < other.y ? other.y : y
+        );
+    }
+
+    /**
+     * Calculate the distance with another vector
+     *
+     * @param other Another vector
+     * @return The distance between the two vectors
+     */
+    qreal distanceWith(const Vector2 other) const {
+        return (*this - other).magnitude();
+    }
+
+    /**
+     * Convert this vector to a point
+     *
+     * @return Point at the coordinates of this vector
+     */
+    constexpr QPointF toPointF() const {
+        return QPointF(x, y);
+    }
 };
 
-#endif   // VECTOR2_HPP
\ No newline at end of file
+// Constants
+inline constexpr Vector2 Vector2::zero(0, 0);
+inline constexpr Vector2 Vector2::up(0, 1);
+inline constexpr Vector2 Vector2::down(0, -1);
+inline constexpr Vector2 Vector2::right(1, 0);
+inline constexpr Vector2 Vector2::left(-1, 0);
+
+// Batch kernels rely on arrays of Vector2 being arrays of (x, y) pairs
+static_assert(std::is_trivially_copyable_v<Vector2>);
+static_assert(std::is_standard_layout_v<Vector2>);
+static_assert(sizeof(Vector2) == 2*sizeof(qreal));
+
+#endif   // VECTOR2_HPP
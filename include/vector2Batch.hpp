@@ -0,0 +1,19 @@
+#ifndef VECTOR2BATCH_HPP
+#define VECTOR2BATCH_HPP
+
+#include <QtGlobal>
+#include "vector2.hpp"
+
+// Kernels over contiguous arrays of Vector2.
+// Use AVX (2 vectors per instruction) or SSE2 (1 vector) when the build targets them,
+// plain Vector2 arithmetic otherwise. Every path gives the same results as the scalar code.
+namespace Vector2Batch {
+    const char* getInstructionSet();
+
+    void normalize(Vector2* vectors, qsizetype count);
+    void distance(const Vector2* from, const Vector2* to, qreal* distances, qsizetype count);
+    void addScaled(Vector2* targets, const Vector2* deltas, qreal scale, qsizetype count);
+    void addScaled(Vector2* targets, const Vector2* deltas, const qreal* scales, qsizetype count);
+}
+
+#endif   // VECTOR2BATCH_HPP
@@ -0,0 +1,47 @@
+#ifndef WEAPONREGISTRY_HPP
+#define WEAPONREGISTRY_HPP
+
+#include <QtGlobal>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "weapon.hpp"
+
+// Id of a weapon definition: its index in the registry, given once by load()
+using WeaponId = qsizetype;
+
+// Every weapon definition of res/weapon, read once into an immutable prototype.
+// Weapons are created by cloning their prototype, so that a drop never reads the disk.
+// A definition is named by its file ("gun/foo.json"); getId() turns that name into a plain index.
+// Not thread-safe: use from the main thread.
+class WeaponRegistry {
+private:
+    static QHash<QString, WeaponId>* ids;       // ids["gun/foo.json"]
+    static QList<const Weapon*>* prototypes;    // Indexed by id
+    static QStringList* filenames;              // Indexed by id
+
+    WeaponRegistry();
+    ~WeaponRegistry();
+
+    static Weapon* loadFile(const QString& filename);
+
+public:
+    static constexpr WeaponId InvalidId = -1;
+
+    static void load();
+    static bool isLoaded();
+    static WeaponId getId(const QString& filename);
+    static QString getFilename(WeaponId id);
+    static qsizetype getCount();
+    static const Weapon* getPrototype(WeaponId id);
+    static Weapon* create(WeaponId id);
+    static void clear();
+};
+
+// Initialize static variables
+inline QHash<QString, WeaponId>* WeaponRegistry::ids = nullptr;
+inline QList<const Weapon*>* WeaponRegistry::prototypes = nullptr;
+inline QStringList* WeaponRegistry::filenames = nullptr;
+
+#endif   // WEAPONREGISTRY_HPP
@@ -0,0 +1,145 @@
+#include <cstdlib>
+#include <new>
+#include "../include/allocationCounter.hpp"
+
+// Replaces the global operator new/delete to count heap allocations, see AllocationCounter.
+// Linked into the executables only (not MallCore), so that counting is an explicit choice of each program.
+
+// --- INTERNALS ---
+
+/**
+ * Allocate memory and count it
+ *
+ * @param size Size of the allocation, in bytes
+ * @return Pointer to the memory, nullptr if out of memory
+ */
+static void* countedAlloc(std::size_t size) {
+    AllocationCounter::record(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+/**
+ * Allocate aligned memory and count it
+ *
+ * @param size Size of the allocation, in bytes
+ * @param alignment Alignment of the allocation, a power of two
+ * @return Pointer to the memory, nullptr if out of memory
+ */
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    AllocationCounter::record(size);
+    std::size_t align = std::size_t(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;      // aligned_alloc wants a multiple of the alignment
+#ifdef _WIN32
+    return _aligned_malloc(rounded > 0 ? rounded : align, align);
+#else
+    return std::aligned_alloc(align, rounded > 0 ? rounded : align);
+#endif
+}
+
+/**
+ * Free memory given by countedAlignedAlloc()
+ *
+ * @param pointer The memory
+ */
+static void alignedFree(void* pointer) {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+// Counters are only reported when the hooks are linked
+[[maybe_unused]] static const bool hooksInstalled = (AllocationCounter::setInstalled(), true);
+
+// --- OPERATOR NEW ---
+
+void* operator new(std::size_t size) {
+    void* pointer = countedAlloc(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = countedAlignedAlloc(size, alignment);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+// --- OPERATOR DELETE ---
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    alignedFree(pointer);
+}
@@ -0,0 +1,291 @@
+#include <QtDebug>
+#include "../include/assetManager.hpp"
+#include "../include/sprite.hpp"
+#include "../include/entity/item.hpp"
+#include "../include/weapon/weaponRegistry.hpp"
+#include "../include/traceRecorder.hpp"
+
+#define IMAGE_PATH "../res/img/"
+
+// --- INTERNALS ---
+
+/**
+ * Create the caches and build the atlas, on first use
+ */
+void AssetManager::init() {
+    if (cache != nullptr) {
+        return;
+    }
+    cache = new QCache<QString, AtlasRegion>(budget);
+    pinned = new QHash<QString, AtlasRegion>();
+    if (!TextureAtlas::isBuilt()) {
+        TextureAtlas::build();
+    }
+}
+
+/**
+ * Look for an image already in memory
+ *
+ * @param fileName Name of image file located in res/img
+ * @param region Written with the page and rect of the image, if found
+ * @return True if the image is resident. "" is always resident (no image).
+ */
+bool AssetManager::findResident(const QString& fileName, AtlasRegion* region) {
+    init();
+    if (fileName.isEmpty()) {
+        *region = AtlasRegion();
+        return true;
+    }
+    if (TextureAtlas::find(fileName, region)) {
+        return true;
+    }
+
+    auto it = pinned->constFind(fileName);
+    if (it != pinned->constEnd()) {
+        *region = it.value();
+        return true;
+    }
+
+    // Marks the image as recently used
+    if (AtlasRegion* cached = cache->object(fileName)) {
+        *region = *cached;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Read and decode an image from the disk
+ *
+ * @param fileName Name of image file located in res/img
+ * @return Region covering the whole image, with a null page if it could not be loaded
+ */
+AtlasRegion AssetManager::load(const QString& fileName) {
+    TraceSpan span("AssetManager::load", "load");
+    QSharedPointer<QImage> image(new QImage(IMAGE_PATH + fileName));
+    if (image->isNull()) {
+        qWarning() << "Failed to load image" << fileName;
+        return AtlasRegion();       // Cached too: a missing image is not looked for again
+    }
+    return AtlasRegion { image, image->rect() };
+}
+
+/**
+ * Put an image in the LRU cache, evicting the least recently used ones if over budget.
+ * An image bigger than the whole budget is pinned instead: dropping it would read it again on every request.
+ *
+ * @param fileName Name of image file located in res/img
+ * @param region Image to keep
+ */
+void AssetManager::store(const QString& fileName, const AtlasRegion& region) {
+    qint64 cost = getCost(region);
+    if (cost > cache->maxCost()) {
+        qWarning() << "Image" << fileName << "takes" << cost / 1024 << "kB, more than the asset budget: pinned";
+        pinned->insert(fileName, region);
+        return;
+    }
+
+    qsizetype countBefore = cache->size();
+    cache->insert(fileName, new AtlasRegion(region), cost);
+    stats.evictions += countBefore + 1 - cache->size();
+}
+
+/**
+ * Get the memory used by an image
+ *
+ * @param region The image
+ * @return Size in bytes
+ */
+qint64 AssetManager::getCost(const AtlasRegion& region) {
+    return region.page ? region.page->sizeInBytes() : 0;
+}
+
+// --- METHODS ---
+
+/**
+ * Get an image, reading it from the disk only if it is not resident
+ *
+ * @param fileName Name of image file located in res/img (should look like "foo.png")
+ * @return Page and rect of the image. Page is nullptr for "" and missing images.
+ */
+AtlasRegion AssetManager::getImage(const QString& fileName) {
+    AtlasRegion region;
+    if (findResident(fileName, &region)) {
+        stats.hits += 1;
+        return region;
+    }
+
+    stats.misses += 1;
+    region = load(fileName);
+    store(fileName, region);
+    return region;
+}
+
+/**
+ * Make images resident ahead of time, so that getImage() does not read the disk later
+ *
+ * @param fileNames Names of image files located in res/img
+ */
+void AssetManager::preload(const QStringList& fileNames) {
+    for (const QString& fileName : fileNames) {
+        AtlasRegion region;
+        if (!findResident(fileName, &region)) {
+            stats.preloads += 1;
+            store(fileName, load(fileName));
+        }
+    }
+}
+
+/**
+ * Make images decoded elsewhere (see AssetPreloader) resident.
+ * Builds the atlas from them if it does not exist yet, so that no image is read twice.
+ *
+ * @param images Decoded images, by name of image file located in res/img. Null for missing images.
+ */
+void AssetManager::addDecoded(const QMap<QString, QImage>& images) {
+    TraceSpan span("AssetManager::addDecoded", "load");
+    if (!TextureAtlas::isBuilt()) {
+        TextureAtlas::build(images);
+    }
+    init();
+
+    for (auto it = images.constBegin(); it != images.constEnd(); ++it) {
+        AtlasRegion region;
+        if (findResident(it.key(), &region)) {
+            continue;
+        }
+        stats.preloads += 1;
+        if (it.value().isNull()) {
+            store(it.key(), AtlasRegion());     // A missing image is not looked for again
+        }
+        else {
+            QSharedPointer<QImage> image(new QImage(it.value()));
+            store(it.key(), AtlasRegion { image, image->rect() });
+        }
+    }
+}
+
+/**
+ * Know whether an image is in memory, without loading anything
+ *
+ * @param fileName Name of image file located in res/img
+ * @return True if getImage() would not read the disk
+ */
+bool AssetManager::isResident(const QString& fileName) {
+    if (fileName.isEmpty()) {
+        return true;
+    }
+    AtlasRegion region;
+    return TextureAtlas::find(fileName, &region)
+        || (pinned && pinned->contains(fileName))
+        || (cache && cache->contains(fileName));
+}
+
+/**
+ * Keep an image resident until unpinned, whatever the budget. Loads it if needed.
+ * Packed images are always resident.
+ *
+ * @param fileName Name of image file located in res/img
+ */
+void AssetManager::pin(const QString& fileName) {
+    init();
+    AtlasRegion region;
+    if (fileName.isEmpty() || TextureAtlas::find(fileName, &region) || pinned->contains(fileName)) {
+        return;
+    }
+
+    if (AtlasRegion* cached = cache->take(fileName)) {
+        region = *cached;
+        delete cached;
+    }
+    else {
+        stats.preloads += 1;
+        region = load(fileName);
+    }
+    pinned->insert(fileName, region);
+}
+
+/**
+ * Let a pinned image be evicted again
+ *
+ * @param fileName Name of image file located in res/img
+ */
+void AssetManager::unpin(const QString& fileName) {
+    init();
+    auto it = pinned->find(fileName);
+    if (it != pinned->end()) {
+        AtlasRegion region = it.value();
+        pinned->erase(it);
+        store(fileName, region);
+    }
+}
+
+/**
+ * Set the memory budget of unpinned images. Evicts images if needed.
+ *
+ * @param bytes New budget, in bytes
+ */
+void AssetManager::setBudget(qint64 bytes) {
+    budget = bytes;
+    if (cache) {
+        qsizetype countBefore = cache->size();
+        cache->setMaxCost(budget);
+        stats.evictions += countBefore - cache->size();
+    }
+}
+
+/**
+ * Get the memory budget of unpinned images
+ *
+ * @return Budget in bytes
+ */
+qint64 AssetManager::getBudget() {
+    return budget;
+}
+
+/**
+ * Get the request counters
+ *
+ * @return Counters since start
+ */
+AssetStats AssetManager::getStats() {
+    return stats;
+}
+
+/**
+ * Print request counters and resident memory
+ *
+ * @param out Stream to print to
+ */
+void AssetManager::print(std::ostream& out) {
+    qint64 pinnedBytes = 0;
+    if (pinned) {
+        for (const AtlasRegion& region : *pinned) {
+            pinnedBytes += getCost(region);
+        }
+    }
+
+    out << "Assets: " << stats.hits << " hits, " << stats.misses << " misses, "
+        << stats.preloads << " preloaded, " << stats.evictions << " evicted" << std::endl;
+    out << "  atlas:  " << TextureAtlas::getBytes() / 1024 << " kB (" << TextureAtlas::getPageCount() << " pages, "
+        << TextureAtlas::getImageCount() << " images)" << std::endl;
+    out << "  pinned: " << pinnedBytes / 1024 << " kB (" << (pinned ? pinned->size() : 0) << " images)" << std::endl;
+    out << "  cached: " << (cache ? cache->totalCost() : 0) / 1024 << " kB (" << (cache ? cache->size() : 0)
+        << " images), budget " << budget / 1024 << " kB" << std::endl;
+    out << "  scaled: " << Sprite::getScaledBytes() / 1024 << " kB (" << Sprite::getScaledCount()
+        << " pixmaps), budget " << Sprite::getScaledBudget() / 1024 << " kB" << std::endl;
+}
+
+/**
+ * Free every asset: images, scaled sprites, the item cache and weapon prototypes. Call once, at exit.
+ */
+void AssetManager::clear() {
+    delete cache;
+    cache = nullptr;
+    delete pinned;
+    pinned = nullptr;
+    TextureAtlas::clear();
+    Sprite::deleteCachedSprites();
+    Item::deleteCache();
+    WeaponRegistry::clear();
+}
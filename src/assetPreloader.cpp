@@ -0,0 +1,233 @@
+#include <QtDebug>
+#include <QtConcurrent>
+#include <QFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include "../include/assetPreloader.hpp"
+#include "../include/assetManager.hpp"
+#include "../include/spriteNames.hpp"
+#include "../include/entity/item.hpp"
+#include "../include/weapon/weaponRegistry.hpp"
+#include "../include/traceRecorder.hpp"
+
+#define IMAGE_PATH "../res/img/"             // Same folder as AssetManager
+#define ITEMSINFO_FILE "../res/items.json"
+#define MOBSINFO_FILE "../res/mob/mobs.json"
+#define RANGEDMOBSINFO_FILE "../res/mob/ranged_mobs.json"
+#define WEAPONINFO_PATH "../res/weapon/"
+
+// --- CONSTRUCTOR/DESTRUCTOR ---
+
+/**
+ * Constructor. Nothing is decoded before start().
+ *
+ * @param parent Parent object
+ */
+AssetPreloader::AssetPreloader(QObject* parent) : QObject(parent) {
+    watcher = new QFutureWatcher<Decoded>(this);
+    connect(watcher, &QFutureWatcher<Decoded>::progressValueChanged, this, [this](int done) {
+        emit progress(done, watcher->progressMaximum());
+    });
+    connect(watcher, &QFutureWatcher<Decoded>::finished, this, &AssetPreloader::onDecoded);
+}
+
+/**
+ * Destructor. Waits for images being decoded, and drops them.
+ */
+AssetPreloader::~AssetPreloader() {
+    watcher->disconnect(this);
+    watcher->cancel();
+    watcher->waitForFinished();
+}
+
+// --- LISTING ---
+
+/**
+ * Add every image named by a JSON value: any string under a key ending with "sprite"
+ * ("sprite", "bullet_sprite"), at any depth.
+ *
+ * @param value JSON value to look into
+ * @param fileNames List to append image names to. Names already in it are skipped.
+ */
+void AssetPreloader::addSprites(const QJsonValue& value, QStringList* fileNames) {
+    if (value.isArray()) {
+        for (const QJsonValue& element : value.toArray()) {
+            addSprites(element, fileNames);
+        }
+    }
+    else if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            if (it.key().endsWith("sprite") && it.value().isString()) {
+                QString fileName = it.value().toString();
+                if (!fileName.isEmpty() && !fileNames->contains(fileName)) {
+                    fileNames->append(fileName);
+                }
+            }
+            else {
+                addSprites(it.value(), fileNames);
+            }
+        }
+    }
+}
+
+/**
+ * Add every image named by a JSON file
+ *
+ * @param jsonFilename Path of the JSON file
+ * @param fileNames List to append image names to
+ */
+void AssetPreloader::addSpritesOf(const QString& jsonFilename, QStringList* fileNames) {
+    QFile file = QFile(jsonFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file" << jsonFilename;
+        return;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (doc.isNull()) {
+        qWarning() << "Failed to parse JSON data.";
+        return;
+    }
+    addSprites(doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object()), fileNames);
+}
+
+/**
+ * List every image a scene can need: sprites of items, mobs and weapons, then SpriteNames
+ *
+ * @return Names of image files located in res/img (look like "foo.png")
+ */
+QStringList AssetPreloader::listSprites() {
+    QStringList fileNames;
+    addSpritesOf(ITEMSINFO_FILE, &fileNames);
+    addSpritesOf(MOBSINFO_FILE, &fileNames);
+    addSpritesOf(RANGEDMOBSINFO_FILE, &fileNames);
+
+    QDir weaponDir(WEAPONINFO_PATH);
+    QStringList jsonFilters = { "*.json" };
+    for (const QString& type : weaponDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+        for (const QString& weapon : QDir(WEAPONINFO_PATH + type).entryList(jsonFilters, QDir::Files, QDir::Name)) {
+            addSpritesOf(WEAPONINFO_PATH + type + "/" + weapon, &fileNames);
+        }
+    }
+
+    // Images named in the code
+    for (const QString& fileName : SpriteNames::getAll()) {
+        if (!fileNames.contains(fileName)) {
+            fileNames.append(fileName);
+        }
+    }
+    return fileNames;
+}
+
+/**
+ * List images a scene can need that are not in memory yet
+ *
+ * @return Names of image files located in res/img. Empty once everything is resident.
+ */
+QStringList AssetPreloader::listMissing() {
+    QStringList fileNames;
+    for (const QString& fileName : listSprites()) {
+        if (!AssetManager::isResident(fileName)) {
+            fileNames.append(fileName);
+        }
+    }
+    return fileNames;
+}
+
+// --- DECODING ---
+
+/**
+ * Read and decode an image. Runs on worker threads.
+ *
+ * @param fileName Name of image file located in res/img
+ * @return Name and image, null if it could not be loaded
+ */
+AssetPreloader::Decoded AssetPreloader::decode(const QString& fileName) {
+    TraceSpan span("AssetPreloader::decode", "load");
+    QImage image(IMAGE_PATH + fileName);
+    if (image.isNull()) {
+        qWarning() << "Failed to load image" << fileName;
+    }
+    else {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);     // Format of atlas pages: packing is a plain copy
+    }
+    return qMakePair(fileName, image);
+}
+
+/**
+ * Hand decoded images to AssetManager, then build the item cache and weapon prototypes from them.
+ * Must run on the main thread.
+ *
+ * @param images Decoded images
+ */
+void AssetPreloader::install(const QList<Decoded>& images) {
+    QMap<QString, QImage> byName;
+    for (const Decoded& image : images) {
+        byName.insert(image.first, image.second);
+    }
+    if (!byName.isEmpty()) {
+        AssetManager::addDecoded(byName);
+    }
+    Item::generateCache();
+    if (!WeaponRegistry::isLoaded()) {
+        WeaponRegistry::load();
+    }
+}
+
+/**
+ * Called when every image of start() is decoded
+ */
+void AssetPreloader::onDecoded() {
+    if (!watcher->isCanceled()) {
+        install(watcher->future().results());
+    }
+    emit finished();
+}
+
+// --- METHODS ---
+
+/**
+ * Decode missing images on the thread pool and wait for them.
+ * Used where there is no event loop (headless runs).
+ */
+void AssetPreloader::preloadBlocking() {
+    TraceSpan span("AssetPreloader::preloadBlocking", "load");
+    QStringList fileNames = listMissing();
+    if (fileNames.isEmpty()) {
+        install({});
+        return;
+    }
+    install(QtConcurrent::blockingMapped<QList<Decoded>>(fileNames, &AssetPreloader::decode));
+}
+
+/**
+ * Start decoding missing images on the thread pool. Returns immediately:
+ * progress() is emitted as images are decoded, finished() once they are all resident.
+ * If everything is already resident, finished() is emitted before returning.
+ */
+void AssetPreloader::start() {
+    if (isRunning()) {
+        return;
+    }
+
+    QStringList fileNames = listMissing();
+    if (fileNames.isEmpty()) {
+        install({});
+        emit finished();
+        return;
+    }
+    emit progress(0, int(fileNames.size()));
+    watcher->setFuture(QtConcurrent::mapped(fileNames, &AssetPreloader::decode));
+}
+
+/**
+ * Know whether images are being decoded
+ *
+ * @return True between start() and finished()
+ */
+bool AssetPreloader::isRunning() const {
+    return watcher->isRunning();
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <iomanip>
+#include "../include/costAccounting.hpp"
+
+// --- ACTIVITIES ---
+
+/**
+ * Get the display name of an activity
+ *
+ * @param activity The activity
+ * @return Name of the activity
+ */
+const char* CostActivities::getName(Activity activity) {
+    switch (activity) {
+        case Update:
+            return "update";
+        case Collide:
+            return "collide";
+        case Paint:
+            return "paint";
+        default:
+            return "";
+    }
+}
+
+// --- METHODS ---
+
+/**
+ * Know whether costs are being recorded
+ *
+ * @return True if costs are recorded
+ */
+bool CostAccounting::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start or stop recording costs
+ *
+ * @param enable True to record costs
+ */
+void CostAccounting::setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+/**
+ * Forget every recorded cost
+ */
+void CostAccounting::reset() {
+    for (int activity=0; activity<CostActivities::Count; activity++) {
+        for (int kind=0; kind<EntityKinds::Count; kind++) {
+            totals[activity][kind].ns.store(0);
+            totals[activity][kind].calls.store(0);
+            windowStartNs[activity][kind] = 0;
+            windowStartCalls[activity][kind] = 0;
+            nsRates[activity][kind] = 0;
+            callRates[activity][kind] = 0;
+        }
+    }
+    startTime = -1;
+    windowStartTime = 0;
+    lastTime = 0;
+}
+
+/**
+ * Record the cost of some calls. Can be called from any thread.
+ *
+ * @param activity What the entities were doing
+ * @param kind Kind of the entities
+ * @param ns Time spent, in nanoseconds
+ * @param calls Amount of calls the time covers
+ */
+void CostAccounting::add(CostActivities::Activity activity, EntityKinds::EntityKind kind, qint64 ns, qint64 calls) {
+    if (!isEnabled()) {
+        return;
+    }
+    totals[activity][kind].ns.fetch_add(ns, std::memory_order_relaxed);
+    totals[activity][kind].calls.fetch_add(calls, std::memory_order_relaxed);
+}
+
+/**
+ * Mark the end of a frame. Rates are computed again once a full window of scene time has passed.
+ * Called on the simulation thread, never while entities are updated.
+ *
+ * @param sceneTime Scene time at the end of the frame, in milliseconds
+ */
+void CostAccounting::endFrame(qint64 sceneTime) {
+    if (!isEnabled()) {
+        return;
+    }
+    if (startTime < 0) {
+        startTime = sceneTime;
+        windowStartTime = sceneTime;
+    }
+    lastTime = sceneTime;
+
+    qint64 windowTime = sceneTime - windowStartTime;
+    if (windowTime < WindowDuration) {
+        return;
+    }
+
+    qreal seconds = windowTime / 1000.0;
+    for (int activity=0; activity<CostActivities::Count; activity++) {
+        for (int kind=0; kind<EntityKinds::Count; kind++) {
+            qint64 ns = totals[activity][kind].ns.load(std::memory_order_relaxed);
+            qint64 calls = totals[activity][kind].calls.load(std::memory_order_relaxed);
+            nsRates[activity][kind] = (ns - windowStartNs[activity][kind]) / seconds;
+            callRates[activity][kind] = (calls - windowStartCalls[activity][kind]) / seconds;
+            windowStartNs[activity][kind] = ns;
+            windowStartCalls[activity][kind] = calls;
+        }
+    }
+    windowStartTime = sceneTime;
+}
+
+/**
+ * Get the time spent per second of scene time, over the last full window
+ *
+ * @param activity What the entities were doing
+ * @param kind Kind of the entities
+ * @return Nanoseconds per second
+ */
+qreal CostAccounting::getTimeRate(CostActivities::Activity activity, EntityKinds::EntityKind kind) {
+    return nsRates[activity][kind];
+}
+
+/**
+ * Get the amount of calls per second of scene time, over the last full window
+ *
+ * @param activity What the entities were doing
+ * @param kind Kind of the entities
+ * @return Calls per second
+ */
+qreal CostAccounting::getCallRate(CostActivities::Activity activity, EntityKinds::EntityKind kind) {
+    return callRates[activity][kind];
+}
+
+/**
+ * Print the costs of the whole run, per second of scene time, most expensive kinds first
+ *
+ * @param out Stream to print to
+ */
+void CostAccounting::print(std::ostream& out) {
+    qreal seconds = (lastTime - startTime) / 1000.0;
+    if (startTime < 0 || seconds <= 0) {
+        out << "Costs: nothing recorded" << std::endl;
+        return;
+    }
+
+    // Sort kinds by total time
+    qint64 kindNs[EntityKinds::Count] = {};
+    int order[EntityKinds::Count];
+    for (int kind=0; kind<EntityKinds::Count; kind++) {
+        order[kind] = kind;
+        for (int activity=0; activity<CostActivities::Count; activity++) {
+            kindNs[kind] += totals[activity][kind].ns.load();
+        }
+    }
+    std::sort(order, order + EntityKinds::Count, [&kindNs](int a, int b) {
+        return kindNs[a] > kindNs[b];
+    });
+
+    out << "Costs over " << seconds << " s of scene time (ms/s, calls/s):" << std::endl;
+    out << "  " << std::left << std::setw(12) << "kind";
+    for (int activity=0; activity<CostActivities::Count; activity++) {
+        out << std::setw(22) << CostActivities::getName(CostActivities::Activity(activity));
+    }
+    out << std::right << std::endl;
+
+    for (int kind : order) {
+        if (kindNs[kind] == 0) {
+            continue;
+        }
+        out << "  " << std::left << std::setw(12) << EntityKinds::getName(EntityKinds::EntityKind(kind)) << std::right;
+        for (int activity=0; activity<CostActivities::Count; activity++) {
+            out << std::fixed << std::setprecision(3) << std::setw(9) << totals[activity][kind].ns.load() / 1e6 / seconds
+                << std::setprecision(0) << std::setw(10) << totals[activity][kind].calls.load() / seconds << "   ";
+        }
+        out << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+}
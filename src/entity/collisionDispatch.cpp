@@ -0,0 +1,91 @@
+#include <array>
+#include "../../include/entity/collisionDispatch.hpp"
+#include "../../include/entity/player.hpp"
+#include "../../include/entity/mob.hpp"
+#include "../../include/entity/rocket.hpp"
+#include "../../include/entity/effectZone.hpp"
+#include "../../include/entity/item.hpp"
+
+// --- HANDLERS ---
+// Kinds are checked by the table, so casts are static
+
+static void playerItem(Entity* self, Entity* other, qint64) {
+    static_cast<Player*>(self)->collideWithItem(static_cast<Item*>(other));
+}
+
+static void playerMob(Entity* self, Entity* other, qint64 deltaTime) {
+    static_cast<Player*>(self)->collideWithMob(static_cast<Mob*>(other), deltaTime);
+}
+
+static void mobPlayer(Entity* self, Entity* other, qint64) {
+    static_cast<Mob*>(self)->collideWithPlayer(static_cast<Player*>(other));
+}
+
+static void missileLiving(Entity* self, Entity* other, qint64 deltaTime) {
+    static_cast<Missile*>(self)->hitLivingEntity(static_cast<LivingEntity*>(other), deltaTime);
+}
+
+static void rocketLiving(Entity* self, Entity* other, qint64 deltaTime) {
+    static_cast<Rocket*>(self)->hitLivingEntity(static_cast<LivingEntity*>(other), deltaTime);
+}
+
+static void zoneLiving(Entity* self, Entity* other, qint64) {
+    static_cast<EffectZone*>(self)->affectLivingEntity(static_cast<LivingEntity*>(other));
+}
+
+static void zoneItem(Entity* self, Entity* other, qint64) {
+    static_cast<EffectZone*>(self)->affectEntity(other);
+}
+
+static void itemPlayer(Entity* self, Entity*, qint64) {
+    static_cast<Item*>(self)->touchPlayer();
+}
+
+// --- TABLE ---
+
+typedef std::array<std::array<CollisionDispatch::Handler, EntityKinds::Count>, EntityKinds::Count> DispatchTable;
+
+/**
+ * Build the dispatch table. Pairs without any reaction are left empty.
+ *
+ * @return Handlers indexed by [kind of self][kind of other]
+ */
+static constexpr DispatchTable buildTable() {
+    DispatchTable table {};
+
+    table[EntityKinds::Player][EntityKinds::Item] = &playerItem;
+    table[EntityKinds::Player][EntityKinds::Mob] = &playerMob;
+    table[EntityKinds::Player][EntityKinds::RangedMob] = &playerMob;
+
+    table[EntityKinds::Mob][EntityKinds::Player] = &mobPlayer;
+    table[EntityKinds::RangedMob][EntityKinds::Player] = &mobPlayer;
+
+    for (EntityKinds::EntityKind living : { EntityKinds::Player, EntityKinds::Mob, EntityKinds::RangedMob }) {
+        table[EntityKinds::Missile][living] = &missileLiving;
+        table[EntityKinds::Rocket][living] = &rocketLiving;
+        table[EntityKinds::EffectZone][living] = &zoneLiving;
+    }
+    table[EntityKinds::EffectZone][EntityKinds::Item] = &zoneItem;
+
+    table[EntityKinds::Item][EntityKinds::Player] = &itemPlayer;
+
+    return table;
+}
+
+static constexpr DispatchTable dispatchTable = buildTable();
+
+// --- METHODS ---
+
+/**
+ * Apply the reaction of an entity colliding with another one
+ *
+ * @param self The entity reacting
+ * @param other The entity self collided with
+ * @param deltaTime Time elapsed since last frame, in milliseconds
+ */
+void CollisionDispatch::resolve(Entity* self, Entity* other, qint64 deltaTime) {
+    Handler handler = dispatchTable[EntityStore::shape(self->storeRow).kind][EntityStore::shape(other->storeRow).kind];
+    if (handler) {
+        handler(self, other, deltaTime);
+    }
+}
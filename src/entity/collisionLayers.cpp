@@ -0,0 +1,103 @@
+#include "../../include/entity/collisionLayers.hpp"
+
+#define TEAM_COUNT 3
+
+/**
+ * Get the collision category of an entity kind
+ * 
+ * @param kind Kind of the entity
+ * @return Category of the kind. CategoryCount if the kind does not collide.
+ */
+CollisionLayers::Category CollisionLayers::categoryOf(EntityKinds::EntityKind kind) {
+    switch (kind) {
+        case EntityKinds::Player:
+            return LivingPlayer;
+        case EntityKinds::Mob:
+        case EntityKinds::RangedMob:
+            return LivingMob;
+        case EntityKinds::Missile:
+        case EntityKinds::Rocket:
+            return Projectile;
+        case EntityKinds::EffectZone:
+            return Zone;
+        case EntityKinds::Item:
+            return Loot;
+        default:
+            return CategoryCount;
+    }
+}
+
+/**
+ * Get the layer bit of a category for a team
+ * 
+ * @param category Collision category
+ * @param team Team of the entity
+ * @return Layer bit. 0 for invalid categories.
+ */
+quint32 CollisionLayers::layerBit(Category category, Teams::Team team) {
+    if (category == CategoryCount) {
+        return 0;
+    }
+    return quint32(1) << (category*TEAM_COUNT + team);
+}
+
+/**
+ * Get the layers of a category, all teams included
+ * 
+ * @param category Collision category
+ * @return Mask of every layer of the category
+ */
+quint32 CollisionLayers::categoryMask(Category category) {
+    return layerBit(category, Teams::None) | layerBit(category, Teams::Player) | layerBit(category, Teams::Ennemy);
+}
+
+/**
+ * Get the layers of a category belonging to other teams
+ * 
+ * @param category Collision category
+ * @param team Team to exclude
+ * @return Mask of the layers of the category, except the one of the team
+ */
+quint32 CollisionLayers::opposingMask(Category category, Teams::Team team) {
+    return categoryMask(category) & ~layerBit(category, team);
+}
+
+/**
+ * Get the layer an entity belongs to
+ * 
+ * @param kind Kind of the entity
+ * @param team Team of the entity
+ * @return Layer bit of the entity
+ */
+quint32 CollisionLayers::layerOf(EntityKinds::EntityKind kind, Teams::Team team) {
+    return layerBit(categoryOf(kind), team);
+}
+
+/**
+ * Get the layers an entity reacts to, matching the handlers of CollisionDispatch
+ * 
+ * @param kind Kind of the entity
+ * @param team Team of the entity
+ * @return Collision mask of the entity
+ */
+quint32 CollisionLayers::defaultMask(EntityKinds::EntityKind kind, Teams::Team team) {
+    switch (categoryOf(kind)) {
+        case LivingPlayer:
+            // Gets hurt by mobs, picks up items
+            return categoryMask(LivingMob) | categoryMask(Loot);
+        case LivingMob:
+            // Targets players
+            return categoryMask(LivingPlayer);
+        case Projectile:
+            // Damages living entities of other teams
+            return opposingMask(LivingPlayer, team) | opposingMask(LivingMob, team);
+        case Zone:
+            // Gives its effect to living entities
+            return categoryMask(LivingPlayer) | categoryMask(LivingMob);
+        case Loot:
+            // Shows its name when touched by a player
+            return categoryMask(LivingPlayer);
+        default:
+            return 0;
+    }
+}
@@ -2,6 +2,9 @@
 #include "../../include/entity/effectZone.hpp"
 #include "../../include/entity/livingEntity.hpp"
 #include "../../include/entity/missile.hpp"
+#include "../../include/entity/collisionLayers.hpp"
+#include "../../include/pool.hpp"
+#include "../../include/spriteNames.hpp"
 
 #define MIN_FORCE_STRENGTH 0.1
 #define MAX_FORCE_STRENGTH 10.0
@@ -56,6 +59,26 @@ EffectZone::EffectZone(Effect effect, const Vector2 position, const qreal range)
  */
 EffectZone::~EffectZone() { }
 
+/**
+ * Allocate memory for a new effect zone from the EffectZone pool
+ * 
+ * @param size Size of the object
+ * @return Pointer to uninitialized memory
+ */
+void* EffectZone::operator new(std::size_t size) {
+    return Pool<EffectZone>::allocate(size);
+}
+
+/**
+ * Give the memory of a destroyed effect zone back to the EffectZone pool
+ * 
+ * @param ptr Memory of the object
+ * @param size Size of the object
+ */
+void EffectZone::operator delete(void* ptr, std::size_t size) {
+    Pool<EffectZone>::deallocate(ptr, size);
+}
+
 // --- INHERITED METHODS ---
 
 /**
@@ -70,37 +93,84 @@ QPainterPath EffectZone::shape() const {
 }
 
 /**
- * Called when this Entity collides with another
+ * Get the layers this zone reacts to, depending on its effect.
+ * Repelling zones also push items; missiles and other zones are never affected.
  * 
- * @param other The entity this object collided with
- * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return Collision mask of this zone
+ */
+quint32 EffectZone::computeCollisionMask() const {
+    using namespace CollisionLayers;
+    quint32 living = categoryMask(LivingPlayer) | categoryMask(LivingMob);
+
+    switch (effect.getType()) {
+        case Effects::EffectType::None:
+            return 0;
+        case Effects::EffectType::Repel:
+        case Effects::EffectType::Boom:
+            return living | categoryMask(Loot);
+        default:
+            return living;
+    }
+}
+
+/**
+ * Get the kind of this entity
+ * 
+ * @return EntityKinds::EffectZone
+ */
+EntityKinds::EntityKind EffectZone::getKind() const {
+    return EntityKinds::EffectZone;
+}
+
+/**
+ * Updating a zone only decreases its own duration
+ * 
+ * @return true
+ */
+bool EffectZone::canUpdateInParallel() const {
+    return true;
+}
+
+/**
+ * Called when this zone touches an entity that can only be moved (items)
+ * 
+ * @param other The entity touched
+ */
+void EffectZone::affectEntity(Entity* other) {
+    switch (effect.getType()) {
+        case Effects::EffectType::Repel:
+        case Effects::EffectType::Boom:
+            repelEntity(other);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Called when this zone touches a living entity
+ * 
+ * @param other The living entity touched
  */
-void EffectZone::onCollide(Entity* other, qint64 deltaTime) {
+void EffectZone::affectLivingEntity(LivingEntity* other) {
     switch (effect.getType()) {
         case Effects::EffectType::None:
             break;
 
         case Effects::EffectType::Repel:
-            // Do not repel missiles or other effect zones
-            if (! (dynamic_cast<Missile*>(other) || dynamic_cast<EffectZone*>(other))) {
-                repelEntity(other);
-            }
+            repelEntity(other);
             break;
 
         case Effects::EffectType::Boom:
-            // Do not repel missiles or other effect zones
-            if (! (dynamic_cast<Missile*>(other) || dynamic_cast<EffectZone*>(other))) {
-                repelEntity(other);
-            }
+            repelEntity(other);
             // Do not break here, we also want to give the boom effect
 
         case Effects::EffectType::Burning:
         case Effects::EffectType::Poisoned:
         case Effects::EffectType::Frozen:
-            if (LivingEntity* ent = dynamic_cast<LivingEntity*>(other)) {
-                // Effect duration is handled by the living entity. If frozen, keep effect zone duration left
-                ent->giveEffect(effect);
-            }
+            // Effect duration is handled by the living entity. If frozen, keep effect zone duration left
+            other->giveEffect(effect);
             break;
     }
 }
@@ -140,19 +210,19 @@ QString EffectZone::getEffectSprite(Effects::EffectType effectType) {
     QString img;
     switch (effectType) {
         case Effects::EffectType::Boom:
-            img = "boom.png";
+            img = SpriteNames::Boom;
             break;
 
         case Effects::EffectType::Burning:
-            img = "fire_zone.png";
+            img = SpriteNames::FireZone;
             break;
 
         case Effects::EffectType::Frozen:
-            img = "ice_zone.png";
+            img = SpriteNames::IceZone;
             break;
 
         case Effects::EffectType::Poisoned:
-            img = "poison_zone.png";
+            img = SpriteNames::PoisonZone;
             break;
 
         default:
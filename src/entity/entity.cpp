@@ -1,4 +1,8 @@
+#include <QElapsedTimer>
 #include "../../include/entity/entity.hpp"
+#include "../../include/entity/collisionLayers.hpp"
+#include "../../include/entity/collisionDispatch.hpp"
+#include "../../include/costAccounting.hpp"
 
 // --- CONSTRUCTORS/DESTRUCTORS ---
 
@@ -6,10 +10,8 @@
  * Default constructor
  */
 Entity::Entity() {
-    setPos(Vector2::zero);
-    dimensions = Vector2::zero;
+    storeRow = EntityStore::add(this);
     sprite = new Sprite();
-    team = Teams::None;
 }
 
 /**
@@ -18,10 +20,14 @@ Entity::Entity() {
  * @param other The entity to copy
  */
 Entity::Entity(const Entity& other) {
-    setPos(other.position);
-    dimensions = other.dimensions;
+    storeRow = EntityStore::add(this);
+    setPos(other.getPos());
+    snapshotPosition();
+    EntityStore::dimension(storeRow) = other.getDims();
+    EntityStore::velocity(storeRow) = other.getVelocity();
+    EntityStore::team(storeRow) = other.getTeam();
+    EntityStore::shape(storeRow) = EntityStore::shape(other.storeRow);
     sprite = new Sprite(*other.sprite);
-    team = other.team;
 }
 
 /**
@@ -32,8 +38,12 @@ Entity::Entity(const Entity& other) {
  * @param sprite Sprite image name (should look like "foo.png")
  * @param team The team this entity belongs to
  */
-Entity::Entity(const Vector2 position, const Vector2 dimensions, const QString& sprite, Teams::Team team) : dimensions(dimensions), team(team) {
+Entity::Entity(const Vector2 position, const Vector2 dimensions, const QString& sprite, Teams::Team team) {
+    storeRow = EntityStore::add(this);
+    EntityStore::dimension(storeRow) = dimensions;
+    EntityStore::team(storeRow) = team;
     setPos(position);
+    snapshotPosition();
     this->sprite = new Sprite(sprite);
 }
 
@@ -41,6 +51,10 @@ Entity::Entity(const Vector2 position, const Vector2 dimensions, const QString&
  * Destructor
  */
 Entity::~Entity() {
+    if (spatialHash) {
+        spatialHash->remove(this);
+    }
+    EntityStore::remove(storeRow);
     delete sprite;
 }
 
@@ -53,7 +67,7 @@ Entity::~Entity() {
  * @return Position of the entity
  */
 Vector2 Entity::getPos() const {
-    return position;
+    return EntityStore::position(storeRow);
 }
 
 /**
@@ -62,7 +76,7 @@ Vector2 Entity::getPos() const {
  * @return Position of center of the entity
  */
 Vector2 Entity::getCenterPos() const {
-    return position + dimensions/2;
+    return getPos() + getDims()/2;
 }
 
 /**
@@ -72,7 +86,7 @@ Vector2 Entity::getCenterPos() const {
  * @return Dimensions of the collision box
  */
 Vector2 Entity::getDims() const {
-    return dimensions;
+    return EntityStore::dimension(storeRow);
 }
 
 /**
@@ -86,23 +100,89 @@ bool Entity::getDeleted() const {
     return isDeleted;
 }
 
+/**
+ * Get the score earned when this entity is removed from the scene
+ * 
+ * @return Score value of this entity
+ */
+qint64 Entity::getScoreValue() const {
+    return 0;
+}
+
+/**
+ * Know whether onUpdate() of this entity may run on a worker thread.
+ * Only true for entities whose update touches nothing but their own state:
+ * no QGraphicsItem call, no allocation of other entities, no shared state.
+ * 
+ * @return True if this entity can be updated in parallel with others
+ */
+bool Entity::canUpdateInParallel() const {
+    return false;
+}
+
 /**
  * Get the team of this entity
  */
 Teams::Team Entity::getTeam() const {
-    return team;
+    return EntityStore::team(storeRow);
+}
+
+/**
+ * Get the kind of this entity. Overridden by every concrete entity.
+ * 
+ * @return Kind of this entity
+ */
+EntityKinds::EntityKind Entity::getKind() const {
+    return EntityKinds::None;
+}
+
+/**
+ * Get the collision layer of this entity
+ * 
+ * @return Layer bit of this entity
+ */
+quint32 Entity::getCollisionLayer() const {
+    return EntityStore::shape(storeRow).layer;
+}
+
+/**
+ * Get the layers this entity reacts to
+ * 
+ * @return Collision mask of this entity
+ */
+quint32 Entity::getCollisionMask() const {
+    return EntityStore::shape(storeRow).mask;
+}
+
+/**
+ * Get the row of this entity in EntityStore. Rows move when other entities are deleted.
+ * 
+ * @return Current row of this entity
+ */
+qsizetype Entity::getStoreRow() const {
+    return storeRow;
+}
+
+/**
+ * Get the velocity of this entity. Zero for entities that do not move on their own.
+ * 
+ * @return Velocity of this entity
+ */
+Vector2 Entity::getVelocity() const {
+    return EntityStore::velocity(storeRow);
 }
 
 // --- SETTERS ---
 
 /**
- * Set position of entity
+ * Set simulation position of entity.
+ * The rendered position only follows on the next call to interpolateRender()
  * 
  * @param pos New position of the entity
  */
 void Entity::setPos(const Vector2 pos) {
-    position = pos;
-    QGraphicsItem::setPos(position.getX(), position.getY());
+    EntityStore::position(storeRow) = pos;
+    updateSpatialHash();
 }
 
 /**
@@ -113,13 +193,24 @@ void Entity::setPos(const Vector2 pos) {
 void Entity::setDims(const Vector2 dims) {
     if (dims.getX() >= 0 && dims.getY() >= 0) {
         prepareGeometryChange();
-        dimensions = dims;
+        EntityStore::dimension(storeRow) = dims;
+        updateSpatialHash();
     }
     else {
         throw std::runtime_error("Dimensions cannot be negative!");
     }
 }
 
+/**
+ * Move this entity to the cells of the collision grid covered by its bounding rect.
+ * Call it whenever the position or the bounding rect changes.
+ */
+void Entity::updateSpatialHash() {
+    if (spatialHash) {
+        spatialHash->update(this);
+    }
+}
+
 /**
  * Set deletion state of this entity
  * Marking this entity as deleted informs the game loop that this entity should be deleted soon.
@@ -141,6 +232,67 @@ void Entity::setSprite(const QString& filename) {
     sprite = new Sprite(filename);
 }
 
+/**
+ * Change the team of this entity. Collision layer follows the new team.
+ * 
+ * @param newTeam The new team of this entity
+ */
+void Entity::setTeam(const Teams::Team newTeam) {
+    EntityStore::team(storeRow) = newTeam;
+    updateCollisionLayer();
+}
+
+/**
+ * Set the velocity of this entity
+ * 
+ * @param newVelocity New velocity of this entity
+ */
+void Entity::setVelocity(const Vector2 newVelocity) {
+    EntityStore::velocity(storeRow) = newVelocity;
+}
+
+// --- SIMULATION/RENDER SYNCHRONIZATION ---
+
+/**
+ * Remember current position as the start of the simulation tick.
+ * Should be called once before each tick.
+ */
+void Entity::snapshotPosition() {
+    EntityStore::previousPosition(storeRow) = EntityStore::position(storeRow);
+}
+
+/**
+ * Move the rendered item between the positions of the last two ticks
+ * 
+ * @param alpha Interpolation factor: 0 renders the previous tick, 1 renders the current one
+ */
+void Entity::interpolateRender(qreal alpha) {
+    Vector2 position = EntityStore::position(storeRow);
+    Vector2 previousPosition = EntityStore::previousPosition(storeRow);
+    Vector2 renderPos = previousPosition + (position - previousPosition) * alpha;
+    QGraphicsItem::setPos(renderPos.getX(), renderPos.getY());
+}
+
+/**
+ * Test whether the shape of this entity overlaps the shape of another.
+ * Uses simulation positions, so it does not depend on what is currently rendered.
+ * 
+ * @param other The other entity
+ * @return True if both shapes intersect
+ */
+bool Entity::collidesWithEntity(const Entity* other) const {
+    if (other == this) {
+        return false;
+    }
+    QPointF offset = (other->getPos() - getPos()).toPointF();
+
+    // Cheap rect test first
+    if (!boundingRect().intersects(other->boundingRect().translated(offset))) {
+        return false;
+    }
+    return shape().intersects(other->shape().translated(offset));
+}
+
 // --- GRAPHICS METHODS ---
 
 /**
@@ -149,20 +301,90 @@ void Entity::setSprite(const QString& filename) {
  * @return bounding rect of this entity
  */
 QRectF Entity::boundingRect() const {
+    Vector2 dimensions = getDims();
     return QRectF(0, 0, dimensions.getX(), dimensions.getY());
 }
 
 /**
- * Paint object on scene
+ * Paint object on scene. Drawing itself is done by draw(), timed when cost accounting is on.
  * 
  * @param painter Painter to draw entity on
  */
 void Entity::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+    if (!CostAccounting::isEnabled()) {
+        draw(painter);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    draw(painter);
+    CostAccounting::add(CostActivities::Paint, EntityStore::shape(storeRow).kind, timer.nsecsElapsed());
+}
+
+/**
+ * Draw object. Overridden by entities that do not simply draw their sprite.
+ * 
+ * @param painter Painter to draw entity on, in item coordinates
+ */
+void Entity::draw(QPainter *painter) {
     // Draw sprite if it exists
     if (sprite != nullptr) {
-        QSharedPointer<QImage> image = sprite->getImage();
-        if (image != nullptr) {
-            painter->drawImage(boundingRect(), *image);
-        }
+        sprite->draw(painter, boundingRect());
+    }
+}
+
+// --- COLLISION FILTERING ---
+
+/**
+ * Get the layers this entity reacts to.
+ * Overridden by entities whose interests depend on their state.
+ * 
+ * @return Collision mask of this entity
+ */
+quint32 Entity::computeCollisionMask() const {
+    return CollisionLayers::defaultMask(getKind(), getTeam());
+}
+
+/**
+ * Cache the kind of this entity and compute its collision layer and mask from its kind and team.
+ * Called when the entity enters a scene and when its team changes.
+ */
+void Entity::updateCollisionLayer() {
+    CollisionShape& shape = EntityStore::shape(storeRow);
+    shape.kind = getKind();
+    shape.layer = CollisionLayers::layerOf(shape.kind, getTeam());
+    shape.mask = computeCollisionMask();
+}
+
+/**
+ * Test whether a collision between this entity and another one could have any effect.
+ * Cheap enough to be done before any shape test.
+ * 
+ * @param other The other entity
+ * @return True if one of the entities reacts to the layer of the other
+ */
+bool Entity::canCollideWith(const Entity* other) const {
+    const CollisionShape& self = EntityStore::shape(storeRow);
+    const CollisionShape& otherShape = EntityStore::shape(other->storeRow);
+    return (self.mask & otherShape.layer) || (otherShape.mask & self.layer);
+}
+
+/**
+ * Called when this entity collides with another.
+ * The reaction is looked up from the kinds of both entities, see CollisionDispatch.
+ * 
+ * @param other The entity this object collided with
+ * @param deltaTime Time elapsed since last frame, in milliseconds
+ */
+void Entity::onCollide(Entity* other, qint64 deltaTime) {
+    if (!CostAccounting::isEnabled()) {
+        CollisionDispatch::resolve(this, other, deltaTime);
+        return;
     }
-}
\ No newline at end of file
+
+    QElapsedTimer timer;
+    timer.start();
+    CollisionDispatch::resolve(this, other, deltaTime);
+    CostAccounting::add(CostActivities::Collide, EntityStore::shape(storeRow).kind, timer.nsecsElapsed());
+}
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <QCoreApplication>
+#include <QThread>
+#include "../../include/entity/entityStore.hpp"
+#include "../../include/entity/entity.hpp"
+
+// --- ROWS ---
+
+/**
+ * Add a row with default components for a new entity
+ *
+ * @param owner The entity owning the row
+ * @return Row of the entity
+ */
+qsizetype EntityStore::add(Entity* owner) {
+    Q_ASSERT_X(isMainThread(), "EntityStore::add", "entities must be created on the main thread");
+    owners.append(owner);
+    positions.append(Vector2::zero);
+    previousPositions.append(Vector2::zero);
+    dimensions.append(Vector2::zero);
+    velocities.append(Vector2::zero);
+    healths.append(Health());
+    effects.append(StatusEffects());
+    teams.append(Teams::None);
+    shapes.append(CollisionShape());
+    flights.append(Flight());
+    return owners.size() - 1;
+}
+
+/**
+ * Remove the row of a deleted entity. Rows stay packed, and active rows stay in front.
+ *
+ * @param row Row to remove
+ */
+void EntityStore::remove(qsizetype row) {
+    Q_ASSERT_X(isMainThread(), "EntityStore::remove", "entities must be deleted on the main thread");
+    if (row < activeCount) {
+        // Fill the hole with the last active row, the hole is now at the end of the active rows
+        activeCount--;
+        moveRow(activeCount, row);
+        row = activeCount;
+    }
+
+    qsizetype last = owners.size() - 1;
+    moveRow(last, row);
+
+    owners.removeLast();
+    positions.removeLast();
+    previousPositions.removeLast();
+    dimensions.removeLast();
+    velocities.removeLast();
+    healths.removeLast();
+    effects.removeLast();
+    teams.removeLast();
+    shapes.removeLast();
+    flights.removeLast();
+}
+
+/**
+ * Mark the row of an entity entering a scene as active, so that systems run on it
+ *
+ * @param entity The entity entering a scene
+ */
+void EntityStore::activate(const Entity* entity) {
+    Q_ASSERT_X(isMainThread(), "EntityStore::activate", "entities must be added to the scene on the main thread");
+    qsizetype row = entity->storeRow;
+    if (row >= activeCount) {
+        swapRows(row, activeCount);
+        activeCount++;
+    }
+}
+
+/**
+ * Copy a row over another one, and tell its owner about its new row
+ *
+ * @param from Row to move
+ * @param to Row to overwrite
+ */
+void EntityStore::moveRow(qsizetype from, qsizetype to) {
+    if (from == to) {
+        return;
+    }
+    owners[to] = owners[from];
+    positions[to] = positions[from];
+    previousPositions[to] = previousPositions[from];
+    dimensions[to] = dimensions[from];
+    velocities[to] = velocities[from];
+    healths[to] = healths[from];
+    effects[to] = effects[from];
+    teams[to] = teams[from];
+    shapes[to] = shapes[from];
+    flights[to] = flights[from];
+    owners[to]->storeRow = to;
+}
+
+/**
+ * Exchange two rows, and tell their owners about their new rows
+ *
+ * @param first, second Rows to exchange
+ */
+void EntityStore::swapRows(qsizetype first, qsizetype second) {
+    if (first == second) {
+        return;
+    }
+    owners.swapItemsAt(first, second);
+    positions.swapItemsAt(first, second);
+    previousPositions.swapItemsAt(first, second);
+    dimensions.swapItemsAt(first, second);
+    velocities.swapItemsAt(first, second);
+    healths.swapItemsAt(first, second);
+    effects.swapItemsAt(first, second);
+    teams.swapItemsAt(first, second);
+    shapes.swapItemsAt(first, second);
+    flights.swapItemsAt(first, second);
+    owners[first]->storeRow = first;
+    owners[second]->storeRow = second;
+}
+
+/**
+ * Know whether the caller runs on the main thread, the only one allowed to add, remove or reorder rows
+ *
+ * @return True on the main thread, or before the application object exists
+ */
+bool EntityStore::isMainThread() {
+    QCoreApplication* app = QCoreApplication::instance();
+    return !app || QThread::currentThread() == app->thread();
+}
+
+// --- SCENE ---
+
+/**
+ * Give the active rows to a new scene. Only one scene may exist at a time:
+ * a second one would mix its entities with the first one in the active rows.
+ *
+ * @param newScene The scene being created
+ */
+void EntityStore::attachScene(const MainScene* newScene) {
+    Q_ASSERT_X(isMainThread(), "EntityStore::attachScene", "scenes must be created on the main thread");
+    Q_ASSERT_X(scene == nullptr, "EntityStore::attachScene", "only one MainScene may exist at a time");
+    scene = newScene;
+}
+
+/**
+ * Release the active rows of a scene being destroyed, once its entities are deleted
+ *
+ * @param oldScene The scene being destroyed
+ */
+void EntityStore::detachScene(const MainScene* oldScene) {
+    Q_ASSERT_X(isMainThread(), "EntityStore::detachScene", "scenes must be destroyed on the main thread");
+    Q_ASSERT_X(scene == oldScene, "EntityStore::detachScene", "scene was not attached");
+    Q_ASSERT_X(activeCount == 0, "EntityStore::detachScene", "entities of the scene are still alive");
+    scene = nullptr;
+}
+
+// --- GETTERS ---
+
+/**
+ * Get the amount of entities alive, in a scene or not
+ *
+ * @return Amount of rows
+ */
+qsizetype EntityStore::getCount() {
+    return owners.size();
+}
+
+/**
+ * Get the amount of entities living in a scene
+ *
+ * @return Amount of active rows
+ */
+qsizetype EntityStore::getActiveCount() {
+    return activeCount;
+}
+
+// --- SYSTEMS ---
+
+/**
+ * Remember current position of every active entity as the start of the simulation tick.
+ * Should be called once before each tick.
+ */
+void EntityStore::snapshotPositions() {
+    std::copy(positions.cbegin(), positions.cbegin() + activeCount, previousPositions.begin());
+}
+
+/**
+ * Move the rendered item of every active entity between its positions of the last two ticks
+ *
+ * @param alpha Interpolation factor: 0 renders the previous tick, 1 renders the current one
+ */
+void EntityStore::interpolateRender(qreal alpha) {
+    const Vector2* current = positions.constData();
+    const Vector2* previous = previousPositions.constData();
+    for (qsizetype row=0; row<activeCount; row++) {
+        Vector2 renderPos = previous[row] + (current[row] - previous[row]) * alpha;
+        owners[row]->QGraphicsItem::setPos(renderPos.getX(), renderPos.getY());
+    }
+}
+
+/**
+ * Move every flying missile along its velocity, and take the distance travelled from its range.
+ * Missiles whose range is over are deleted by their next onUpdate().
+ * Walks active rows from a given one, so that rows activated during the tick can be moved later in the same tick.
+ * Must run on the main thread: moved entities update the collision grid.
+ *
+ * @param from First row to move
+ * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return Row to start from next time: rows activated after this call come after it
+ */
+qsizetype EntityStore::moveMissiles(qsizetype from, qint64 deltaTime) {
+    Vector2* position = positions.data();
+    const Vector2* velocity = velocities.constData();
+    Flight* flight = flights.data();
+    for (qsizetype row=from; row<activeCount; row++) {
+        if (!flight[row].enabled) {
+            continue;
+        }
+        Vector2 travel = velocity[row]*deltaTime;
+        position[row] = position[row] + travel;
+        flight[row].range -= travel.magnitude();
+        owners[row]->updateSpatialHash();
+    }
+    return activeCount;
+}
@@ -1,6 +1,9 @@
 #include "../../include/entity/item.hpp"
 #include "../../include/entity/player.hpp"
 #include "../../include/lootTables.hpp"
+#include "../../include/weapon/weaponRegistry.hpp"
+#include "../../include/pool.hpp"
+#include "../../include/traceRecorder.hpp"
 
 #include <QDebug>
 
@@ -13,9 +16,6 @@
  * @param belongsToCache Whether this item belongs to cache or not
  */
 Item::Item(bool belongsToCache) : isInCache(belongsToCache) {
-    if (!belongsToCache) {
-        itemsCount += 1;
-    }
     loadDefaultValues();
 }
 
@@ -32,7 +32,6 @@ Item::Item(const Item& other) : Entity(other), itemType(other.itemType), itemStr
         itemWeapon = nullptr;
     }
     isInCache = false;      // A copied item never belongs to cache
-    itemsCount += 1;
 }
 
 /**
@@ -58,9 +57,7 @@ Item* Item::copy() const {
 Item::Item(const Vector2 position, const Vector2 dimensions, ItemType::ItemType itemType, const QString& sprite, const QString& name, const qint64 strength, bool belongsToCache) :
     Entity(position, dimensions, sprite), itemType(itemType), itemStrength(strength), name(name), isInCache(belongsToCache)
 {
-    if (!belongsToCache) {
-        itemsCount += 1;
-    }
+
 }
 
 /**
@@ -68,12 +65,26 @@ Item::Item(const Vector2 position, const Vector2 dimensions, ItemType::ItemType
  */
 Item::~Item() {
     delete itemWeapon;
-    if (!isInCache) {
-        itemsCount -= 1;
-        if (itemsCount == 0) {
-            deleteCache();
-        }
-    }
+}
+
+/**
+ * Allocate memory for a new item from the Item pool
+ * 
+ * @param size Size of the object
+ * @return Pointer to uninitialized memory
+ */
+void* Item::operator new(std::size_t size) {
+    return Pool<Item>::allocate(size);
+}
+
+/**
+ * Give the memory of a destroyed item back to the Item pool
+ * 
+ * @param ptr Memory of the object
+ * @param size Size of the object
+ */
+void Item::operator delete(void* ptr, std::size_t size) {
+    Pool<Item>::deallocate(ptr, size);
 }
 
 /**
@@ -88,9 +99,6 @@ Item::~Item() {
  * @param belongsToCache Whether this item belongs to cache or not
  */
 Item::Item(const QJsonObject& jsonItem, bool belongsToCache) : isInCache(belongsToCache) {
-    if (!belongsToCache) {
-        itemsCount += 1;
-    }
     setType(jsonItem["type"].toString());
     if (itemType == ItemType::Weapon) {
         name = "";
@@ -106,7 +114,7 @@ Item::Item(const QJsonObject& jsonItem, bool belongsToCache) : isInCache(belongs
 
 /**
  * Pattern factory. Loads informations from the cache.
- * Calling this for the first time or after deleting the cache can be slow.
+ * Calling this before generateCache() can be slow.
  * See generateCache() to prebuild the cache
  * 
  * @param itemName Name of the item.
@@ -123,7 +131,7 @@ Item* Item::create(const QString& itemName, const Vector2 position) {
 
         // If the product is a weapon
         if (product->getType() == ItemType::Weapon) {
-            Weapon* weapon = Weapon::create(LootTables::getRandomLoot(cachedItem->weaponTable));
+            Weapon* weapon = WeaponRegistry::create(LootTables::getRandomWeapon(cachedItem->weaponTable));
             if (!weapon || weapon->isEmpty()) {
                 qWarning() << "Weapon at" << cachedItem->weaponTable << "is empty";
             } else {
@@ -148,17 +156,20 @@ void Item::loadDefaultValues() {
 // --- INHERITED METHODS ---
 
 /**
- * Called when this Entity collides with another
+ * Get the kind of this entity
  * 
- * @param other The entity this object collided with
- * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return EntityKinds::Item
  */
-void Item::onCollide(Entity* other, qint64 deltaTime) {
-    if (Player* player = dynamic_cast<Player*>(other)) {
-        touchingPlayer = true;
+EntityKinds::EntityKind Item::getKind() const {
+    return EntityKinds::Item;
+}
 
-        // Pickup item by Player is handled by Player class
-    }
+/**
+ * Called when a player touches this item
+ * Pickup item by Player is handled by Player class
+ */
+void Item::touchPlayer() {
+    touchingPlayer = true;
 }
 
 /**
@@ -190,11 +201,11 @@ Entity* Item::getSpawned() {
 }
 
 /**
- * Paint item on scene
+ * Draw item on scene
  * 
  * @param painter Painter to draw entity on
  */
-void Item::paint(QPainter *painter, const QStyleOptionGraphicsItem* styleOption, QWidget* widget) {
+void Item::draw(QPainter *painter) {
     Vector2 dims = getDims();
 
     // Paint name if any and if item should show its name
@@ -218,18 +229,12 @@ void Item::paint(QPainter *painter, const QStyleOptionGraphicsItem* styleOption,
     // If item is a weapon, paint weapon sprite instead of item sprite
     if (getType() == ItemType::Weapon && itemWeapon) {
         if (const Sprite* sprite = itemWeapon->getSprite()) {
-            QSharedPointer<QImage> image = sprite->getImage();
-            if (image != nullptr) {
-                painter->drawImage(QRectF(0, 0, dims.getX(), dims.getY()), *image);
-            }
+            sprite->draw(painter, QRectF(0, 0, dims.getX(), dims.getY()));
         }
     }
     else {
         if (sprite != nullptr) {
-            QSharedPointer<QImage> image = sprite->getImage();
-            if (image != nullptr) {
-                painter->drawImage(Entity::boundingRect(), *image);
-            }
+            sprite->draw(painter, Entity::boundingRect());
         }
     }
 }
@@ -378,9 +383,13 @@ void Item::setType(const QString& typeName) {
 }
 
 /**
- * Generate item cache
+ * Generate item cache. Does nothing if it already exists: the cache lives until AssetManager::clear().
  */
 void Item::generateCache() {
+    if (itemsCache != nullptr) {
+        return;
+    }
+    TraceSpan span("Item::generateCache", "load");
     itemsCache = new QMap<QString, Item*>();
     // Open file
     QFile file = QFile(ITEMSINFO_FILE);    // Copied from gun.cpp
@@ -6,9 +6,7 @@
  * Default constructor
  */
 LivingEntity::LivingEntity() {
-    life = 1;
-    maxLife = 1;
-    isDead = false;
+    EntityStore::health(getStoreRow()) = Health { 1, 1, false };
     initEffects();
 }
 
@@ -17,10 +15,9 @@ LivingEntity::LivingEntity() {
  * 
  * @param other Another LivingEntity
  */
-LivingEntity::LivingEntity(const LivingEntity& other) :
-    Entity(other), life(other.life), maxLife(other.maxLife), isDead(other.isDead), burning(other.burning), poisoned(other.poisoned), frozen(other.frozen), speed(other.speed)
-{
-
+LivingEntity::LivingEntity(const LivingEntity& other) : Entity(other), speed(other.speed) {
+    EntityStore::health(getStoreRow()) = EntityStore::health(other.getStoreRow());
+    EntityStore::effect(getStoreRow()) = EntityStore::effect(other.getStoreRow());
 }
 
 /**
@@ -34,9 +31,8 @@ LivingEntity::LivingEntity(const LivingEntity& other) :
  * @param team The team this entity belongs to
  */
 LivingEntity::LivingEntity(qreal life, const qreal speed, const Vector2 position, const Vector2 dimensions, const QString& sprite, Teams::Team team) : Entity(position, dimensions, sprite, team) {
-    this->life = life > 0 ? life : 1;   // Do not start with 0 HP
-    maxLife = this->life;
-    isDead = false;
+    life = life > 0 ? life : 1;   // Do not start with 0 HP
+    EntityStore::health(getStoreRow()) = Health { life, life, false };
     this->speed = speed;
     initEffects();
 }
@@ -54,7 +50,7 @@ LivingEntity::~LivingEntity() { }
  * @return Life of the living entity
  */
 qreal LivingEntity::getLife() const {
-    return life;
+    return EntityStore::health(getStoreRow()).life;
 }
 
 /**
@@ -63,7 +59,7 @@ qreal LivingEntity::getLife() const {
  * @return Life of the living entity
  */
 qreal LivingEntity::getMaxLife() const {
-    return maxLife;
+    return EntityStore::health(getStoreRow()).maxLife;
 }
 
 /**
@@ -72,6 +68,7 @@ qreal LivingEntity::getMaxLife() const {
  * @return Speed multiplier of this entity
  */
 qreal LivingEntity::getSpeedMultiplier() const {
+    const Effect& frozen = EntityStore::effect(getStoreRow()).frozen;
     if (frozen.hasDied()) {
         return 1;
     }
@@ -105,7 +102,7 @@ qreal LivingEntity::getSpeed() const {
  * @return Whether this entity is in a dead state or not
  */
 bool LivingEntity::getIsDead() const {
-    return isDead;
+    return EntityStore::health(getStoreRow()).dead;
 }
 
 // --- SETTERS ---
@@ -116,24 +113,26 @@ bool LivingEntity::getIsDead() const {
  * @param life New life of the entity
  */
 void LivingEntity::setLife(const qreal newLife) {
-    if (newLife > maxLife) {
-        life = maxLife;
+    Health& health = EntityStore::health(getStoreRow());
+    if (newLife > health.maxLife) {
+        health.life = health.maxLife;
     }
     else if (newLife <= 0) {
-        life = 0;
+        health.life = 0;
         this->onDeath();
     }
     else {
-        life = newLife;
+        health.life = newLife;
     }
 }
 
 void LivingEntity::setMaxLife(const qreal newMaxLife) {
-    maxLife = newMaxLife>0 ? newMaxLife : 1;
+    Health& health = EntityStore::health(getStoreRow());
+    health.maxLife = newMaxLife>0 ? newMaxLife : 1;
 
     // If max life becomes smaller than current life, then entity looses the difference
-    if (life > maxLife) {
-        life = maxLife;
+    if (health.life > health.maxLife) {
+        health.life = health.maxLife;
     }
 }
 
@@ -143,27 +142,26 @@ void LivingEntity::setMaxLife(const qreal newMaxLife) {
  * @param damage Damage the living entity should take
  */
 void LivingEntity::takeDamage(const qreal damage) {
-    if (damage > life) {
-        life = 0;
-        isDead = true;
+    Health& health = EntityStore::health(getStoreRow());
+    if (damage > health.life) {
+        health.life = 0;
+        health.dead = true;
         this->onDeath();
     }
     else {
-        life -= damage;
+        health.life -= damage;
     }
 }
 
 /**
- * Set entity looking side status
+ * Set entity looking side status.
+ * Only changes which sprite variant is drawn, not the geometry: no QGraphicsItem call,
+ * so it is safe from a parallel update.
  * 
  * @param lookingLeft True if looking at left, false otherwise
  */
 void LivingEntity::setLookingLeft(const bool lookingLeft) {
-    // Only update geometry is new looking direction is different from previous one
-    if (isLookingLeft != lookingLeft) {
-        prepareGeometryChange();
-        isLookingLeft = lookingLeft;
-    }
+    isLookingLeft = lookingLeft;
 }
 
 
@@ -187,9 +185,10 @@ void LivingEntity::setSpeed(const qreal speed) {
  * Initialize living entity effects
  */
 void LivingEntity::initEffects() {
-    burning = Effect(Effects::EffectType::Burning, 0, 0);
-    poisoned = Effect(Effects::EffectType::Poisoned, 0, 0);
-    frozen = Effect(Effects::EffectType::Frozen, 0, 0);
+    StatusEffects& effects = EntityStore::effect(getStoreRow());
+    effects.burning = Effect(Effects::EffectType::Burning, 0, 0);
+    effects.poisoned = Effect(Effects::EffectType::Poisoned, 0, 0);
+    effects.frozen = Effect(Effects::EffectType::Frozen, 0, 0);
 }
 
 /**
@@ -198,6 +197,11 @@ void LivingEntity::initEffects() {
  * @param effect The effect to give. If effect is frozen, this method will take effect duration. For all other effect types, duration is handled by this method
  */
 void LivingEntity::giveEffect(const Effect& effect) {
+    StatusEffects& effects = EntityStore::effect(getStoreRow());
+    Effect& burning = effects.burning;
+    Effect& poisoned = effects.poisoned;
+    Effect& frozen = effects.frozen;
+
     switch (effect.getType()) {
         // Burning/poisoned/frozen : make effect last longer if new duration is bigger
         // And set new strength if new strength is bigger
@@ -239,25 +243,34 @@ void LivingEntity::giveEffect(const Effect& effect) {
  * @return Whether this entity wants to spawn another entity or not
  */
 bool LivingEntity::onUpdate(qint64 deltaTime) {
+    // Runs on worker threads during the parallel update: onDeath() must not create entities there,
+    // only ask for them through getSpawned() (EntityStore::add() asserts it). The store rows do not move meanwhile.
+    StatusEffects& effects = EntityStore::effect(getStoreRow());
+
     // Update burning effect
+    Effect& burning = effects.burning;
     if (burning.hasDied()) {
         burning.setStrength(0);
     }
     else {
-        takeDamage(deltaTime*burning.getStrength());
+        qreal burningStrength = burning.getStrength();
         burning.decreaseDuration(deltaTime);
+        takeDamage(deltaTime*burningStrength);
     }
 
     // Update poisoned effect
+    Effect& poisoned = effects.poisoned;
     if (poisoned.hasDied()) {
         poisoned.setStrength(0);
     }
     else {
-        takeDamage(deltaTime*poisoned.getStrength());
+        qreal poisonedStrength = poisoned.getStrength();
         poisoned.decreaseDuration(deltaTime);
+        takeDamage(deltaTime*poisonedStrength);
     }
 
     // Update frozen effect
+    Effect& frozen = effects.frozen;
     if (frozen.hasDied()) {
         frozen.setStrength(1);      // Less strong freeze possible
     }
@@ -266,4 +279,15 @@ bool LivingEntity::onUpdate(qint64 deltaTime) {
     }
 
     return false;
+}
+
+/**
+ * Draw living entity, using the mirrored variant of its sprite when looking left
+ * 
+ * @param painter Painter to draw entity on
+ */
+void LivingEntity::draw(QPainter *painter) {
+    if (sprite != nullptr) {
+        sprite->draw(painter, boundingRect(), getLookingLeft());
+    }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "../../include/entity/missile.hpp"
+#include "../../include/entity/entityStore.hpp"
 #include "../../include/entity/livingEntity.hpp"
+#include "../../include/pool.hpp"
 
 // --- CONSTRUCTOR/DESTRUCTOR ---
 
@@ -7,10 +9,10 @@
  * Default constructor
  */
 Missile::Missile() {
-    velocity = Vector2::zero;
-    lifetime = 0;
+    EntityStore::flight(getStoreRow()).enabled = true;
     damage = 0;
     pierceEntities = false;
+    updateRotation();
 }
 
 /**
@@ -18,7 +20,11 @@ Missile::Missile() {
  * 
  * @param other The missile to copy
  */
-Missile::Missile(const Missile& other) : Entity(other), velocity(other.velocity), lifetime(other.lifetime), damage(other.damage), pierceEntities(other.pierceEntities) { }
+Missile::Missile(const Missile& other) : Entity(other), damage(other.damage), pierceEntities(other.pierceEntities),
+    heading(other.heading), rotatedBounds(other.rotatedBounds), rotatedShape(other.rotatedShape)
+{
+    EntityStore::flight(getStoreRow()) = EntityStore::flight(other.getStoreRow());
+}
 
 /**
  * Constructor
@@ -33,9 +39,13 @@ Missile::Missile(const Missile& other) : Entity(other), velocity(other.velocity)
  * @param team The team this entity belongs to
  */
 Missile::Missile(const Vector2 velocity, const qreal range, const qreal damage, const bool pierceEntities, const Vector2 position, const Vector2 dimensions, const QString& sprite, Teams::Team team) :
-    Entity(position, dimensions, sprite, team), velocity(velocity), lifetime(range), damage(damage), pierceEntities(pierceEntities)
+    Entity(position, dimensions, sprite, team), damage(damage), pierceEntities(pierceEntities)
 {
-
+    Flight& flight = EntityStore::flight(getStoreRow());
+    flight.enabled = true;
+    flight.range = range;
+    setVelocity(velocity);
+    updateRotation();
 }
 
 /**
@@ -43,6 +53,26 @@ Missile::Missile(const Vector2 velocity, const qreal range, const qreal damage,
  */
 Missile::~Missile() { }
 
+/**
+ * Allocate memory for a new missile from the Missile pool
+ * 
+ * @param size Size of the object
+ * @return Pointer to uninitialized memory
+ */
+void* Missile::operator new(std::size_t size) {
+    return Pool<Missile>::allocate(size);
+}
+
+/**
+ * Give the memory of a destroyed missile back to the Missile pool
+ * 
+ * @param ptr Memory of the object
+ * @param size Size of the object
+ */
+void Missile::operator delete(void* ptr, std::size_t size) {
+    Pool<Missile>::deallocate(ptr, size);
+}
+
 /**
  * Copy missile on a new pointer
  * 
@@ -60,7 +90,7 @@ Missile* Missile::copy() const {
  * @return Velocity of the missile
  */
 Vector2 Missile::getSpeed() const {
-    return velocity;
+    return getVelocity();
 }
 
 // --- SETTERS ---
@@ -72,48 +102,70 @@ Vector2 Missile::getSpeed() const {
  */
 void Missile::setSpeed(const Vector2 speed) {
     prepareGeometryChange();
-    velocity = speed;
+    setVelocity(speed);
+    updateRotation();
+    updateSpatialHash();        // Bounding rect follows the heading
 }
 
 // --- INHERITED METHODS ---
 
 /**
- * Called when this Entity collides with another
+ * Get the kind of this entity
  * 
- * @param other The entity this object collided with
+ * @return EntityKinds::Missile
+ */
+EntityKinds::EntityKind Missile::getKind() const {
+    return EntityKinds::Missile;
+}
+
+/**
+ * Updating a missile only changes its own state: spawns are created later by getSpawned()
+ * 
+ * @return true
+ */
+bool Missile::canUpdateInParallel() const {
+    return true;
+}
+
+/**
+ * Called when this missile touches a living entity
+ * 
+ * @param entity The living entity hit
  * @param deltaTime Time elapsed since last frame, in milliseconds
  */
-void Missile::onCollide(Entity* other, qint64 deltaTime) {
-    if (LivingEntity* entity = dynamic_cast<LivingEntity*>(other)) {
-        if (entity->getTeam() != getTeam()) {
-            entity->takeDamage(damage*deltaTime*60/1000);       // values in json are in dmg per frame (60 fps)
+void Missile::hitLivingEntity(LivingEntity* entity, qint64 deltaTime) {
+    if (entity->getTeam() != getTeam()) {
+        entity->takeDamage(damage*deltaTime*60/1000);       // values in json are in dmg per frame (60 fps)
 
-            // If does not pierce entities, delete this entity
-            if (!pierceEntities) {
-                setDeleted(true);
-            }
+        // If does not pierce entities, delete this entity
+        if (!pierceEntities) {
+            setDeleted(true);
         }
     }
 }
 
 /**
- * Called once per frame
+ * Called once per frame. The missile was already moved by EntityStore::moveMissiles().
  * 
  * @param deltaTime Time elapsed since last frame, in milliseconds
  * @return Whether this entity wants to spawn another entity or not
  */
 bool Missile::onUpdate(qint64 deltaTime) {
-    Vector2 travel = velocity*deltaTime;
-    setPos(getPos() + travel);
-
-    // Handle max missile travel distance
-    lifetime -= travel.magnitude();
-    if (lifetime < 0) {
+    if (isRangeOver()) {
         setDeleted(true);
     }
     return false;
 }
 
+/**
+ * Know whether this missile travelled its max distance
+ * 
+ * @return True if it should despawn
+ */
+bool Missile::isRangeOver() const {
+    return EntityStore::flight(getStoreRow()).range < 0;
+}
+
 /**
  * Get next Entity this entity wants to spawn
  * 
@@ -124,33 +176,34 @@ Entity* Missile::getSpawned() {
 }
 
 /**
- * Paint missile on scene
+ * Draw missile on scene
  * 
  * @param painter Painter to draw entity on
  */
-void Missile::paint(QPainter *painter, const QStyleOptionGraphicsItem* styleOption, QWidget* widget) {
-    // Draw sprite if it exists
+void Missile::draw(QPainter *painter) {
+    // Draw sprite if it exists. Rotated images are cached by the sprite: no painter transform needed
     if (sprite != nullptr) {
-        QSharedPointer<QImage> image = sprite->getImage();
-        if (image != nullptr) {
-            painter->save();
-
-            // Tried to refactor code here, using getRotationTF() and painter->setTransform()
-            // But it was buggy and was taking too long. Feel free to change if you know how to do.
-            qreal angle = -velocity.angleWith(Vector2::right);
-            QRectF originalRect = baseBoundingRect();
-            painter->translate(originalRect.center());
-            painter->rotate(angle);
-            painter->translate(-originalRect.center());
-
-            painter->drawImage(originalRect, *image);
-
-            painter->restore();
-        }
+        sprite->drawRotated(painter, baseBoundingRect(), heading);
     }
 }
 
+/**
+ * Get boundingRect of this missile, holding its rotated sprite
+ * 
+ * @return Bounding rect, computed when velocity was set
+ */
 QRectF Missile::boundingRect() const {
+    return rotatedBounds;
+}
+
+/**
+ * Compute the heading of this missile from its velocity, then its rotated bounds and shape.
+ * Called every time velocity changes.
+ */
+void Missile::updateRotation() {
+    Vector2 velocity = getVelocity();
+    heading = velocity.sqrMagnitude() > 0 ? -velocity.angleWith(Vector2::right) : 0;
+
     QRectF originalRect = baseBoundingRect();
     QPointF rectCenter = originalRect.center();
 
@@ -168,8 +221,12 @@ QRectF Missile::boundingRect() const {
     qreal minY = qMin(qMin(topLeft.y(), topRight.y()), qMin(botLeft.y(), botRight.y()));
     qreal maxX = qMax(qMax(topLeft.x(), topRight.x()), qMax(botLeft.x(), botRight.x()));
     qreal maxY = qMax(qMax(topLeft.y(), topRight.y()), qMax(botLeft.y(), botRight.y()));
+    rotatedBounds = QRectF(minX, minY, maxX - minX, maxY - minY);
 
-    return QRectF(minX, minY, maxX - minX, maxY - minY);
+    // Rotated ellipse
+    QPainterPath path;
+    path.addEllipse(originalRect);
+    rotatedShape = tf.map(path);
 }
 
 /**
@@ -188,15 +245,7 @@ QRectF Missile::baseBoundingRect() const {
  * @return shape of the missile
  */
 QPainterPath Missile::shape() const {
-    QPainterPath path;
-
-    QRectF originalRect = baseBoundingRect();
-    QTransform tf = getRotationTF(originalRect.center());
-
-    path.addEllipse(originalRect);
-    path = tf.map(path);
-
-    return path;
+    return rotatedShape;
 }
 
 /**
@@ -209,7 +258,7 @@ QTransform Missile::getRotationTF(QPointF rectCenter) const {
     // Rotation around center
     QTransform tf;
     tf.translate(rectCenter.x(), rectCenter.y());
-    tf.rotate(-velocity.angleWith(Vector2::right));
+    tf.rotate(heading);
     tf.translate(-rectCenter.x(), -rectCenter.y());
     return tf;
 }
\ No newline at end of file
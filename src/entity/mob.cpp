@@ -58,9 +58,7 @@ Mob::Mob(const qreal life, const qreal damage, const qreal speed, const Vector2
 /**
  * Destructor
  */
-Mob::~Mob() {
-    delete loot;
-}
+Mob::~Mob() { }
 
 /**
  * Copy mob on a new pointer
@@ -80,26 +78,35 @@ void Mob::onDeath() {
     // Can't die multiple times
     if (! isDeleted) {
         setDeleted(true);
-        delete loot;
-        loot = getRandomLoot();
-        if (loot->isEmpty()) {
-            delete loot;
-            loot = nullptr;
-        }
+        lootPending = true;
     }
 }
 
 /**
- * Called when this Entity collides with another
+ * Get the kind of this entity
  * 
- * @param other The entity this object collided with
- * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return EntityKinds::Mob
  */
-void Mob::onCollide(Entity* other, qint64 deltaTime) {
-    // If colliding with a player, change target
-    if (Player* player = dynamic_cast<Player*>(other)) {
-        target = player;
-    }
+EntityKinds::EntityKind Mob::getKind() const {
+    return EntityKinds::Mob;
+}
+
+/**
+ * Updating a mob only changes its own state: spawns are created later by getSpawned()
+ * 
+ * @return true
+ */
+bool Mob::canUpdateInParallel() const {
+    return true;
+}
+
+/**
+ * Called when this mob touches a player
+ * 
+ * @param player The player touched. Becomes the target of this mob.
+ */
+void Mob::collideWithPlayer(Player* player) {
+    target = player;
 }
 
 /**
@@ -109,8 +116,13 @@ void Mob::onCollide(Entity* other, qint64 deltaTime) {
  * @return Whether this entity wants to spawn another entity or not
  */
 bool Mob::onUpdate(qint64 deltaTime) {
-    moveTowardTarget(deltaTime);
-    return LivingEntity::onUpdate(deltaTime) || loot;
+    if (moveDone) {
+        moveDone = false;
+    }
+    else {
+        moveTowardTarget(deltaTime);
+    }
+    return LivingEntity::onUpdate(deltaTime) || lootPending;
 }
 
 /**
@@ -119,9 +131,13 @@ bool Mob::onUpdate(qint64 deltaTime) {
  * @return Pointer to the new entity. nullptr if no other entity to spawn.
  */
 Entity* Mob::getSpawned() {
-    if (loot) {
-        Item* newItem = loot;
-        loot = nullptr;
+    if (lootPending) {
+        lootPending = false;
+        Item* newItem = getRandomLoot();
+        if (newItem->isEmpty()) {
+            delete newItem;
+            return nullptr;
+        }
         return newItem;
     }
     else {
@@ -159,7 +175,7 @@ Item* Mob::getRandomLoot() const {
  */
 bool Mob::getDeleted() const {
     // Delay deletion: mob death timing may cause the item to fail looting
-    return LivingEntity::getDeleted() && !loot;
+    return LivingEntity::getDeleted() && !lootPending;
 }
 
 /**
@@ -171,6 +187,15 @@ qint64 Mob::getScoreValue() const {
     return scoreValue;
 }
 
+/**
+ * Get the target of this mob
+ * 
+ * @return The player this mob chases, nullptr if none
+ */
+Player* Mob::getTarget() const {
+    return target;
+}
+
 /**
  * Set a new target for this mob.
  * Mobs always exclusively attack towards their target
@@ -267,8 +292,24 @@ void Mob::loadAllMobs(QMap<QString, Mob*>* mobs) {
  */
 void Mob::moveTowardTarget(qint64 deltaTime) {
     if (target) {
-        Vector2 movement = (target->getCenterPos() - getCenterPos()).normalized();
-        movement = movement * getSpeedMultiplier() * getSpeed() * deltaTime;
-        setPos(getPos() + movement);
+        Vector2 direction = (target->getCenterPos() - getCenterPos()).normalized();
+        setPos(getPos() + direction * getStepLength(deltaTime));
     }
+}
+
+/**
+ * Get the distance this mob walks in one tick, slowed down by freezing effects
+ * 
+ * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return Length of the step
+ */
+qreal Mob::getStepLength(qint64 deltaTime) const {
+    return getSpeedMultiplier() * getSpeed() * deltaTime;
+}
+
+/**
+ * Skip the movement of the next update, because this mob was already moved by MobSteering
+ */
+void Mob::skipNextMove() {
+    moveDone = true;
 }
\ No newline at end of file
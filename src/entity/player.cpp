@@ -142,7 +142,7 @@ void Player::addGold(const qint64 amount) {
  */
 bool Player::gatherItem(Item* item) {
     bool succeeded = false;
-    if (!isDead) {
+    if (!getIsDead()) {
         // Player wants to gather only 1 item per key input
         grabKeyPressed = false;
 
@@ -283,21 +283,34 @@ Weapon* Player::getActiveWeapon() const {
 void Player::onDeath() { }
 
 /**
- * Called when this Entity collides with another
+ * Get the kind of this entity
  * 
- * @param other The entity this object collided with
- * @param deltaTime Time elapsed since last frame, in milliseconds
+ * @return EntityKinds::Player
  */
-void Player::onCollide(Entity* other, qint64 deltaTime) {
-    if (Item* item = dynamic_cast<Item*>(other)) {
-        if (grabKeyPressed) {
-            gatherItem(item);
-        }
+EntityKinds::EntityKind Player::getKind() const {
+    return EntityKinds::Player;
+}
+
+/**
+ * Called when this player touches an item
+ * 
+ * @param item The item touched
+ */
+void Player::collideWithItem(Item* item) {
+    if (grabKeyPressed) {
+        gatherItem(item);
     }
-    else if (Mob* mob = dynamic_cast<Mob*>(other)) {
-        if (mob->getTeam() != getTeam()) {
-            takeDamage(mob->getDamage()*deltaTime*60/1000);     // values in json are in dmg per frame (60 fps)
-        }
+}
+
+/**
+ * Called when this player touches a mob
+ * 
+ * @param mob The mob touched
+ * @param deltaTime Time elapsed since last frame, in milliseconds
+ */
+void Player::collideWithMob(Mob* mob, qint64 deltaTime) {
+    if (mob->getTeam() != getTeam()) {
+        takeDamage(mob->getDamage()*deltaTime*60/1000);     // values in json are in dmg per frame (60 fps)
     }
 }
 
@@ -310,7 +323,7 @@ void Player::onCollide(Entity* other, qint64 deltaTime) {
 bool Player::onUpdate(qint64 deltaTime) {
     bool wantSpawn = LivingEntity::onUpdate(deltaTime) || droppedWeapon;
 
-    if (!isDead) {
+    if (!getIsDead()) {
         // Decrease weapon cooldown
         if (weaponDelay > 0) {
             weaponDelay -= deltaTime;
@@ -395,42 +408,31 @@ QRectF Player::boundingRect() const {
 }
 
 /**
- * Paint player on scene
+ * Draw player on scene
  * 
  * @param painter Painter to draw entity on
  */
-void Player::paint(QPainter *painter, const QStyleOptionGraphicsItem* styleOption, QWidget* widget) {
-    // If looking left, mirror player render along y axis
-    if (getLookingLeft()) {
-        Vector2 dims = getDims();
-        QPointF center = QPointF(dims.getX()/2, dims.getY()/2);
-        painter->translate(center);
-        painter->scale(-1, 1);  // Flip image on y axis
-        painter->translate(-center);
-    }
+void Player::draw(QPainter *painter) {
+    // If looking left, use mirrored sprites, as if the render was flipped around the center of the player
+    bool lookingLeft = getLookingLeft();
+    Vector2 dims = getDims();
 
     // Draw player sprite if it exists
     if (sprite != nullptr) {
-        QSharedPointer<QImage> image = sprite->getImage();
-        if (image != nullptr) {
-            Vector2 dims = getDims();
-            painter->drawImage(QRectF(0, 0, dims.getX(), dims.getY()), *image);
-        }
+        sprite->draw(painter, QRectF(0, 0, dims.getX(), dims.getY()), lookingLeft);
     }
     
-    // Draw active weapon (if any)
+    // Draw active weapon (if any), held on the side the player looks at
     Weapon* activeWeapon = getActiveWeapon();
     if (activeWeapon) {
         if (const Sprite* weaponSprite = activeWeapon->getSprite()) {
-            if (QSharedPointer<QImage> image = weaponSprite->getImage()) {
-                Vector2 weaponDims = activeWeapon->getDims();
-                painter->drawImage(QRectF(
-                    0,
-                    getDims().getY()/2 - weaponDims.getY()/2,
-                    weaponDims.getX(),
-                    weaponDims.getY()),
-                    *image);
-            }
+            Vector2 weaponDims = activeWeapon->getDims();
+            weaponSprite->draw(painter, QRectF(
+                lookingLeft ? dims.getX() - weaponDims.getX() : 0,
+                dims.getY()/2 - weaponDims.getY()/2,
+                weaponDims.getX(),
+                weaponDims.getY()),
+                lookingLeft);
         }
     }
 }
@@ -497,7 +499,7 @@ void Player::actionUseWeapon(Vector2 direction) {
             }
 
             // Attack at the correct position and direction
-            heldWeapon->attack(attackPos, direction, team);
+            heldWeapon->attack(attackPos, direction, getTeam());
             consumeEnergy(consumption);
             weaponDelay = heldWeapon->getDelay();
         }
@@ -569,7 +571,7 @@ void Player::actionSetGrabPress(bool isGrabbing) {
 void Player::actionChangeWeapon() {
     // Using a switch here because it's easier to add new slots this way.
     prepareGeometryChange();
-    if (!isDead) {
+    if (!getIsDead()) {
         switch (activeWeaponSlot) {
             case Inventory::WeaponSlot_1:
                 activeWeaponSlot = Inventory::WeaponSlot_2;
@@ -588,6 +590,40 @@ void Player::actionChangeWeapon() {
     update();
 }
 
+/**
+ * Apply a recorded player action
+ * 
+ * @param action The action to apply
+ */
+void Player::applyAction(const PlayerAction& action) {
+    switch (action.type) {
+        case PlayerActions::LeftMovement:
+            actionSetLeftMovement(action.x);
+            break;
+        case PlayerActions::RightMovement:
+            actionSetRightMovement(action.x);
+            break;
+        case PlayerActions::UpMovement:
+            actionSetUpMovement(action.x);
+            break;
+        case PlayerActions::DownMovement:
+            actionSetDownMovement(action.x);
+            break;
+        case PlayerActions::GrabPress:
+            actionSetGrabPress(action.x != 0);
+            break;
+        case PlayerActions::UsingWeapon:
+            actionSetUsingWeapon(action.x != 0);
+            break;
+        case PlayerActions::TargetDirection:
+            actionSetTargetDirection(Vector2(action.x, action.y));
+            break;
+        case PlayerActions::ChangeWeapon:
+            actionChangeWeapon();
+            break;
+    }
+}
+
 /**
  * Player action:
  * Set use weapon key press state
@@ -607,11 +643,15 @@ void Player::actionSetUsingWeapon(const bool isUsingWeapon) {
 void Player::actionSetTargetDirection(const Vector2 direction) {
     targetDir = direction.normalized();
 
-    // Update looking direction
+    // Update looking direction. Geometry does not change, only the rendered sprites.
+    bool wasLookingLeft = getLookingLeft();
     if (direction.getX() < 0) {
         setLookingLeft(true);
     }
     else if (direction.getX() > 0) {
         setLookingLeft(false);
     }
+    if (getLookingLeft() != wasLookingLeft) {
+        update();
+    }
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ RangedMob::RangedMob(const RangedMob& other) : Mob(other), fireCooldown(other.fi
     minShootingDistance(other.minShootingDistance), maxShootingDistance(other.maxShootingDistance), shootStateActive(other.shootStateActive)
 {
     bulletCache = other.bulletCache->copy();
-    bulletSpawn = nullptr;
+    shotPending = false;
     delay = 0;
 }
 
@@ -48,7 +48,6 @@ RangedMob::RangedMob(const QJsonObject& mobObject, Player* target) {
  */
 RangedMob::~RangedMob() {
     delete bulletCache;
-    delete bulletSpawn;
 }
 
 /**
@@ -82,7 +81,7 @@ bool RangedMob::loadFromJson(const QJsonObject& mobObject) {
     fireCooldown = mobObject["fire_cooldown"].toInteger();
     minShootingDistance = mobObject["min_shoot_distance"].toDouble();
     maxShootingDistance = mobObject["max_shoot_distance"].toDouble();
-    team = Teams::Ennemy;
+    setTeam(Teams::Ennemy);
 
     // Load the bullet
     QString bulletType = mobObject["bullet_type"].toString();
@@ -131,7 +130,7 @@ void RangedMob::initDefaultValues() {
     minShootingDistance = 0;
     maxShootingDistance = 0;
     bulletCache = new Missile();
-    bulletSpawn = nullptr;
+    shotPending = false;
 
     Mob::initDefaultValues();
 }
@@ -167,6 +166,15 @@ void RangedMob::loadAllMobs(QMap<QString, Mob*>* mobs) {
 
 // -- INHERITED METHODS ---
 
+/**
+ * Get the kind of this entity
+ * 
+ * @return EntityKinds::RangedMob
+ */
+EntityKinds::EntityKind RangedMob::getKind() const {
+    return EntityKinds::RangedMob;
+}
+
 /**
  * Called once per frame
  * 
@@ -189,17 +197,17 @@ bool RangedMob::onUpdate(qint64 deltaTime)  {
         }
         else {
             shootStateActive = true;
-            if (!bulletSpawn && delay <= 0) {
-                // Shoot a bullet towards target
+            if (!shotPending && delay <= 0) {
+                // Shoot a bullet towards target. The bullet itself is created by getSpawned()
                 delay = fireCooldown;
-                bulletSpawn = bulletCache->copy();
-                bulletSpawn->setPos(centerPos - bulletSpawn->getDims()/2);
-                bulletSpawn->setSpeed((target->getCenterPos() - centerPos).normalized()*missileSpeed);
+                shotPending = true;
+                shotOrigin = centerPos;
+                shotVelocity = (target->getCenterPos() - centerPos).normalized()*missileSpeed;
             }
         }
     }
 
-    return LivingEntity::onUpdate(deltaTime) || bulletSpawn || loot;
+    return LivingEntity::onUpdate(deltaTime) || shotPending || lootPending;
 }
 
 /**
@@ -209,9 +217,11 @@ bool RangedMob::onUpdate(qint64 deltaTime)  {
  * @return Pointer to the new entity. nullptr if no other entity to spawn.
  */
 Entity* RangedMob::getSpawned() {
-    if (bulletSpawn) {
-        Missile* newMissile = bulletSpawn;
-        bulletSpawn = nullptr;
+    if (shotPending) {
+        shotPending = false;
+        Missile* newMissile = bulletCache->copy();
+        newMissile->setPos(shotOrigin - newMissile->getDims()/2);
+        newMissile->setSpeed(shotVelocity);
         return newMissile;
     }
     else {
@@ -1,5 +1,6 @@
 #include "../../include/entity/rocket.hpp"
 #include "../../include/entity/livingEntity.hpp"
+#include "../../include/pool.hpp"
 
 // --- CONSTRUCTORS/DESTRUCTOR ---
 
@@ -65,6 +66,26 @@ Rocket::~Rocket() {
     delete effect;
 }
 
+/**
+ * Allocate memory for a new rocket from the Rocket pool
+ * 
+ * @param size Size of the object
+ * @return Pointer to uninitialized memory
+ */
+void* Rocket::operator new(std::size_t size) {
+    return Pool<Rocket>::allocate(size);
+}
+
+/**
+ * Give the memory of a destroyed rocket back to the Rocket pool
+ * 
+ * @param ptr Memory of the object
+ * @param size Size of the object
+ */
+void Rocket::operator delete(void* ptr, std::size_t size) {
+    Pool<Rocket>::deallocate(ptr, size);
+}
+
 /**
  * Copy rocket on a new pointer
  * 
@@ -84,37 +105,39 @@ void Rocket::explode() {
 }
 
 /**
- * Called when this Entity collides with another
+ * Get the kind of this entity
+ * 
+ * @return EntityKinds::Rocket
+ */
+EntityKinds::EntityKind Rocket::getKind() const {
+    return EntityKinds::Rocket;
+}
+
+/**
+ * Called when this rocket touches a living entity
  * 
- * @param other The entity this object collided with
+ * @param entity The living entity hit
  * @param deltaTime Time elapsed since last frame, in milliseconds
  */
-void Rocket::onCollide(Entity* other, qint64 deltaTime) {
-    if (LivingEntity* entity = dynamic_cast<LivingEntity*>(other)) {
-        if (entity->getTeam() != getTeam()) {
-            entity->takeDamage(damage*deltaTime*60/1000);       // values in json are in dmg per frame (60 fps)
-
-            // If does not pierce entities, make it explode
-            if (!pierceEntities) {
-                explode();
-            }
+void Rocket::hitLivingEntity(LivingEntity* entity, qint64 deltaTime) {
+    if (entity->getTeam() != getTeam()) {
+        entity->takeDamage(damage*deltaTime*60/1000);       // values in json are in dmg per frame (60 fps)
+
+        // If does not pierce entities, make it explode
+        if (!pierceEntities) {
+            explode();
         }
     }
 }
 
 /**
- * Called once per frame
+ * Called once per frame. The rocket was already moved by EntityStore::moveMissiles().
  * 
  * @param deltaTime Time elapsed since last frame, in milliseconds
  * @return Whether this entity wants to spawn another entity or not
  */
 bool Rocket::onUpdate(qint64 deltaTime) {
-    Vector2 travel = velocity*deltaTime;
-    setPos(getPos() + travel);
-
-    // Handle max missile travel distance
-    lifetime -= travel.magnitude();
-    if (lifetime < 0) {
+    if (isRangeOver()) {
         explode();
     }
 
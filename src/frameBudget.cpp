@@ -0,0 +1,168 @@
+#include <limits>
+#include <QDebug>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "../include/frameBudget.hpp"
+#include "../include/vector2.hpp"
+
+#define ALLOCATION_SLACK 1.0   // Absolute allocations per tick always allowed above the baseline
+#define REFERENCE_POINTS 4096   // Size of the reference workload
+#define REFERENCE_PASSES 64
+#define REFERENCE_RUNS 5        // The fastest run is kept, the others absorb noise
+
+/**
+ * Compare one metric with its budget and print the result
+ *
+ * @param out Stream to print to
+ * @param name Name of the metric
+ * @param value Measured value
+ * @param base Baseline value
+ * @param limit Worst accepted value
+ * @param higherIsBetter True if the value must stay above the limit, false if below
+ * @return True if the value is within budget
+ */
+static bool checkMetric(std::ostream& out, const char* name, qreal value, qreal base, qreal limit, bool higherIsBetter) {
+    bool ok = higherIsBetter ? value >= limit : value <= limit;
+    out << "  " << name << value << " (baseline " << base << ", limit " << limit << ")"
+        << (ok ? "  ok" : "  OVER BUDGET") << std::endl;
+    return ok;
+}
+
+/**
+ * Time a fixed workload on this machine: vector math and hash lookups, like a tick.
+ * Run durations divided by this are comparable across machines.
+ *
+ * @return Duration of the workload, in milliseconds (fastest of a few runs)
+ */
+qreal FrameBudget::measureReference() {
+    QList<Vector2> points;
+    QHash<qint32, qsizetype> cells;
+    points.reserve(REFERENCE_POINTS);
+    for (qsizetype i=0; i<REFERENCE_POINTS; i++) {
+        points.append(Vector2(qreal(i % 64) * 17, qreal(i / 64) * 13));
+    }
+
+    qint64 best = std::numeric_limits<qint64>::max();
+    qreal total = 0;
+    for (int run=0; run<REFERENCE_RUNS; run++) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int pass=0; pass<REFERENCE_PASSES; pass++) {
+            cells.clear();
+            for (qsizetype i=0; i<REFERENCE_POINTS; i++) {
+                Vector2 moved = points.at(i).rotate(qreal(pass));
+                total += (moved - points.at((i * 7) % REFERENCE_POINTS)).magnitude();
+                cells[qint32(moved.getX()) / 128 * 1024 + qint32(moved.getY()) / 128] += 1;
+            }
+            total += cells.size();
+        }
+        best = qMin(best, timer.nsecsElapsed());
+    }
+    if (total < 0) {
+        qDebug() << total;      // Never true: keeps the workload from being optimized out
+    }
+    return best / 1e6;
+}
+
+/**
+ * Load a baseline file.
+ * A file holding only the scenario (spawner, seed, ticks) loads, but is not measured.
+ *
+ * @param filename JSON file written by save()
+ * @return False if the file could not be read
+ */
+bool FrameBudget::load(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file" << filename;
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (doc.isNull() || !doc.isObject()) {
+        qWarning() << "Failed to parse JSON data.";
+        return false;
+    }
+
+    QJsonObject object = doc.object();
+    spawnerFilename = object["spawner"].toString();
+    seed = object["seed"].toString().toULongLong();    // String: JSON numbers lose 64-bit precision
+    ticks = object["ticks"].toInteger();
+    tickDuration = object["tick_ms"].toInteger();
+    tolerance = object["tolerance"].toDouble(DefaultTolerance);
+
+    // Times are stored in reference units (see measureReference()), converted to milliseconds by check()
+    measured = object.contains("mean_tick_ref");
+    baseline.meanTickMs = object["mean_tick_ref"].toDouble();
+    baseline.p99TickMs = object["p99_tick_ref"].toDouble();
+    baseline.allocationsPerTick = object["heap_allocations_per_tick"].toDouble();
+    baseline.entityThroughput = object["entity_updates_per_ref"].toDouble();
+    return true;
+}
+
+/**
+ * Save this baseline to a file
+ *
+ * @param filename JSON file to write
+ * @return False if the file could not be written
+ */
+bool FrameBudget::save(const QString& filename) const {
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open file" << filename;
+        return false;
+    }
+
+    qreal reference = baseline.referenceMs > 0 ? baseline.referenceMs : 1;
+    QJsonObject object;
+    object.insert("spawner", spawnerFilename);
+    object.insert("seed", QString::number(seed));
+    object.insert("ticks", ticks);
+    object.insert("tick_ms", tickDuration);
+    object.insert("tolerance", tolerance);
+    object.insert("reference_ms", baseline.referenceMs);    // Informative only
+    object.insert("mean_tick_ref", baseline.meanTickMs / reference);
+    object.insert("p99_tick_ref", baseline.p99TickMs / reference);
+    object.insert("heap_allocations_per_tick", baseline.allocationsPerTick);
+    object.insert("entity_updates_per_ref", baseline.entityThroughput * reference / 1000);
+    file.write(QJsonDocument(object).toJson());
+    return true;
+}
+
+/**
+ * Check the metrics of a run of the scenario against this baseline
+ *
+ * @param metrics Metrics of the new run
+ * @param out Stream to print the comparison to
+ * @return True if every metric is within budget
+ */
+bool FrameBudget::check(const RunMetrics& metrics, std::ostream& out) const {
+    if (!measured) {
+        out << "Budget: FAIL, the baseline of this scenario was never recorded (see --write-budget)" << std::endl;
+        return false;
+    }
+
+    // Baseline times converted to this machine, using the reference workload timed during this run
+    qreal reference = metrics.referenceMs;
+    qreal baseMean = baseline.meanTickMs * reference;
+    qreal baseP99 = baseline.p99TickMs * reference;
+    qreal baseThroughput = reference > 0 ? baseline.entityThroughput * 1000 / reference : 0;
+
+    qreal slower = 1 + tolerance;
+    out << "Budget (tolerance " << tolerance*100 << " %, reference workload " << reference << " ms):" << std::endl;
+
+    bool ok = true;
+    ok &= checkMetric(out, "mean tick (ms):       ", metrics.meanTickMs, baseMean, baseMean * slower, false);
+    ok &= checkMetric(out, "p99 tick (ms):        ", metrics.p99TickMs, baseP99, baseP99 * slower, false);
+    ok &= checkMetric(out, "heap allocs per tick: ", metrics.allocationsPerTick, baseline.allocationsPerTick,
+                      baseline.allocationsPerTick * slower + ALLOCATION_SLACK, false);
+    ok &= checkMetric(out, "entity updates/sec:   ", metrics.entityThroughput, baseThroughput,
+                      baseThroughput / slower, true);
+
+    out << (ok ? "Budget: PASS" : "Budget: FAIL") << std::endl;
+    return ok;
+}
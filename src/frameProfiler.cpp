@@ -0,0 +1,249 @@
+#include <cmath>
+#include <QDebug>
+#include "../include/frameProfiler.hpp"
+#include "../include/traceRecorder.hpp"
+#include "../include/costAccounting.hpp"
+
+// --- PHASES ---
+
+/**
+ * Get the display name of a phase
+ * 
+ * @param phase The phase
+ * @return Name of the phase, also used as CSV column prefix
+ */
+const char* ProfilePhases::getName(Phase phase) {
+    switch (phase) {
+        case Collisions:
+            return "collisions";
+        case Update:
+            return "update";
+        case Cleanup:
+            return "cleanup";
+        case Spawn:
+            return "spawn";
+        case Step:
+            return "step";
+        case Render:
+            return "render";
+        default:
+            return "";
+    }
+}
+
+// --- PHASE HISTOGRAM ---
+
+/**
+ * Get the bucket of a duration
+ * 
+ * @param ns Duration, in nanoseconds
+ * @return Index of the bucket. Bucket 0 holds everything under 1 µs.
+ */
+int PhaseHistogram::bucketOf(qint64 ns) {
+    qreal us = ns / 1000.0;
+    if (us < 1) {
+        return 0;
+    }
+    int bucket = int(std::log2(us) * BucketsPerDoubling) + 1;
+    return qMin(bucket, BucketCount - 1);
+}
+
+/**
+ * Get the duration represented by a bucket: the geometric middle of its bounds
+ * 
+ * @param bucket Index of the bucket
+ * @return Duration, in nanoseconds
+ */
+qreal PhaseHistogram::bucketValue(int bucket) {
+    if (bucket == 0) {
+        return 500;
+    }
+    return std::exp2((bucket - 0.5) / BucketsPerDoubling) * 1000;
+}
+
+/**
+ * Add a sample, evicting the oldest one once the window is full
+ * 
+ * @param ns Duration, in nanoseconds
+ */
+void PhaseHistogram::add(qint64 ns) {
+    if (windowFill == WindowSize) {
+        counts[window[windowPos]] -= 1;
+    }
+    else {
+        windowFill += 1;
+    }
+
+    int bucket = bucketOf(ns);
+    window[windowPos] = quint8(bucket);
+    counts[bucket] += 1;
+    windowPos = (windowPos + 1) % WindowSize;
+}
+
+/**
+ * Get a percentile of the samples of the window
+ * 
+ * @param p Percentile, in [0; 1]
+ * @return Approximate duration, in nanoseconds. 0 without samples.
+ */
+qreal PhaseHistogram::percentile(qreal p) const {
+    if (windowFill == 0) {
+        return 0;
+    }
+
+    qsizetype rank = qsizetype(std::ceil(p * windowFill));
+    qsizetype seen = 0;
+    for (int bucket=0; bucket<BucketCount; bucket++) {
+        seen += counts[bucket];
+        if (seen >= rank && counts[bucket] > 0) {
+            return bucketValue(bucket);
+        }
+    }
+    return bucketValue(BucketCount - 1);
+}
+
+/**
+ * Get the amount of samples in the window
+ * 
+ * @return Amount of samples
+ */
+qsizetype PhaseHistogram::getSampleCount() const {
+    return windowFill;
+}
+
+// --- FRAME PROFILER ---
+
+/**
+ * Constructor
+ */
+FrameProfiler::FrameProfiler() { }
+
+/**
+ * Destructor
+ */
+FrameProfiler::~FrameProfiler() {
+    stopCsv();
+}
+
+/**
+ * Get the rolling histogram of a phase
+ * 
+ * @param phase The phase
+ * @return Histogram of the phase
+ */
+const PhaseHistogram& FrameProfiler::getHistogram(ProfilePhases::Phase phase) const {
+    return histograms[phase];
+}
+
+/**
+ * Get the amount of entities given to the last endFrame()
+ * 
+ * @return Amount of entities
+ */
+qsizetype FrameProfiler::getLastEntityCount() const {
+    return lastEntityCount;
+}
+
+/**
+ * Record the duration of one run of a phase
+ * 
+ * @param phase The phase
+ * @param ns Duration, in nanoseconds
+ */
+void FrameProfiler::addSample(ProfilePhases::Phase phase, qint64 ns) {
+    histograms[phase].add(ns);
+    frameTotals[phase] += ns;
+}
+
+/**
+ * Close the current frame: write its CSV row, if enabled, and reset the frame totals.
+ * A frame may contain several ticks, or none.
+ * 
+ * @param entityCount Amount of entities at the end of the frame
+ * @param sceneTime Simulated time at the end of the frame, in milliseconds
+ */
+void FrameProfiler::endFrame(qsizetype entityCount, qint64 sceneTime) {
+    lastEntityCount = entityCount;
+
+    if (csvStream) {
+        *csvStream << frameIndex << ',' << sceneTime;
+        for (int phase=0; phase<ProfilePhases::Count; phase++) {
+            *csvStream << ',' << frameTotals[phase] / 1000;
+        }
+        *csvStream << ',' << qint64(entityCount) << '\n';
+    }
+
+    for (int phase=0; phase<ProfilePhases::Count; phase++) {
+        frameTotals[phase] = 0;
+    }
+    frameIndex += 1;
+    CostAccounting::endFrame(sceneTime);
+}
+
+/**
+ * Start streaming one row per frame to a CSV file. Durations are in microseconds.
+ * 
+ * @param filename File to write to
+ * @return True if the file could be opened
+ */
+bool FrameProfiler::startCsv(const QString& filename) {
+    stopCsv();
+
+    csvFile = new QFile(filename);
+    if (!csvFile->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "Failed to open file" << filename;
+        delete csvFile;
+        csvFile = nullptr;
+        return false;
+    }
+
+    csvStream = new QTextStream(csvFile);
+    *csvStream << "frame,scene_time_ms";
+    for (int phase=0; phase<ProfilePhases::Count; phase++) {
+        *csvStream << ',' << ProfilePhases::getName(ProfilePhases::Phase(phase)) << "_us";
+    }
+    *csvStream << ",entities\n";
+    return true;
+}
+
+/**
+ * Flush and close the CSV file
+ */
+void FrameProfiler::stopCsv() {
+    if (csvStream) {
+        csvStream->flush();
+        delete csvStream;
+        csvStream = nullptr;
+    }
+    delete csvFile;
+    csvFile = nullptr;
+}
+
+// --- PROFILE SCOPE ---
+
+/**
+ * Constructor. Starts the timer.
+ * 
+ * @param profiler Profiler receiving the duration. nullptr to disable.
+ * @param phase Phase being timed
+ */
+ProfileScope::ProfileScope(FrameProfiler* profiler, ProfilePhases::Phase phase) : profiler(profiler), phase(phase) {
+    if (profiler) {
+        timer.start();
+    }
+    if (TraceRecorder::isEnabled()) {
+        traceStart = TraceRecorder::now();
+    }
+}
+
+/**
+ * Destructor. Records the time spent in the scope.
+ */
+ProfileScope::~ProfileScope() {
+    if (profiler) {
+        profiler->addSample(phase, timer.nsecsElapsed());
+    }
+    if (traceStart >= 0) {
+        TraceRecorder::addSpan(ProfilePhases::getName(phase), "frame", traceStart, TraceRecorder::now());
+    }
+}
@@ -0,0 +1,267 @@
+#include <iostream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+#include "../include/headlessRunner.hpp"
+#include "../include/mainScene.hpp"
+#include "../include/pool.hpp"
+#include "../include/allocationCounter.hpp"
+#include "../include/costAccounting.hpp"
+#include "../include/frameBudget.hpp"
+#include "../include/assetManager.hpp"
+#include "../include/assetPreloader.hpp"
+#include "../include/entity/rocket.hpp"
+#include "../include/entity/item.hpp"
+
+// --- CONSTRUCTOR/DESTRUCTOR ---
+
+/**
+ * Constructor
+ * 
+ * @param ticks Amount of simulation steps to run
+ * @param tickDuration Simulated time of one step, in milliseconds
+ * @param spawnerFilename Spawner to use (should look like "foo.json"). Empty to keep the scene default.
+ */
+HeadlessRunner::HeadlessRunner(qint64 ticks, qint64 tickDuration, const QString& spawnerFilename) :
+    ticks(ticks > 0 ? ticks : 1), tickDuration(tickDuration > 0 ? tickDuration : 1), spawnerFilename(spawnerFilename)
+{
+
+}
+
+/**
+ * Destructor
+ */
+HeadlessRunner::~HeadlessRunner() { }
+
+// --- SETTERS ---
+
+/**
+ * Record the run to a session file
+ * 
+ * @param filename File to write the session to. Empty to disable.
+ */
+void HeadlessRunner::setRecordFile(const QString& filename) {
+    recordFilename = filename;
+}
+
+/**
+ * Replay a session file instead of running free.
+ * Seed, spawner and tick durations come from the file; the run lasts as long as the session.
+ * 
+ * @param filename File written by a recording. Empty to disable.
+ */
+void HeadlessRunner::setReplayFile(const QString& filename) {
+    replayFilename = filename;
+}
+
+/**
+ * Force the seed of the simulation random generators
+ * 
+ * @param newSeed The seed
+ */
+void HeadlessRunner::setSeed(quint64 newSeed) {
+    seed = newSeed;
+    hasSeed = true;
+}
+
+/**
+ * Choose between moving chasing mobs in one batched pass or one by one.
+ * Both must end with the same state checksum for the same seed.
+ * 
+ * @param enabled True to use the batched pass (default)
+ */
+void HeadlessRunner::setBatchSteeringEnabled(bool enabled) {
+    batchSteering = enabled;
+}
+
+/**
+ * Stream the duration of each phase of each tick to a CSV file
+ * 
+ * @param filename File to write to. Empty to disable.
+ */
+void HeadlessRunner::setProfileCsvFile(const QString& filename) {
+    profileCsvFilename = filename;
+}
+
+/**
+ * Check the run against a stored baseline, or store the run as the new baseline.
+ * When checking, the scenario (spawner, seed, ticks, tick duration) comes from the baseline file.
+ * 
+ * @param filename Baseline file. Empty to disable.
+ * @param write True to write the baseline, false to check against it
+ */
+void HeadlessRunner::setBudgetFile(const QString& filename, bool write) {
+    budgetFilename = filename;
+    writeBudget = write;
+}
+
+// --- PRIVATE METHODS ---
+
+/**
+ * Print the counters of an entity pool on one line
+ * 
+ * @param name Name of the pooled type
+ * @param stats Counters of the pool
+ */
+void HeadlessRunner::printPoolStats(const char* name, const PoolStats& stats) {
+    std::cout << "  " << name << ": " << stats.allocations << " allocs, "
+              << stats.slabs << " slabs (" << stats.capacity << " slots), "
+              << stats.live << " live (peak " << stats.peakLive << ")" << std::endl;
+}
+
+/**
+ * Get the peak resident memory of the process
+ * 
+ * @return Peak resident set size, in kilobytes. -1 if unknown on this platform.
+ */
+qint64 HeadlessRunner::getPeakRss() {
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef Q_OS_DARWIN
+    return usage.ru_maxrss / 1024;     // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+// --- METHODS ---
+
+/**
+ * Run the simulation and print a summary on standard output
+ * 
+ * @return Exit code of the run
+ */
+int HeadlessRunner::run() {
+    FrameBudget budget;
+    if (budgetFilename != "" && (!writeBudget || QFile::exists(budgetFilename))) {
+        // Same scenario as the baseline. Recording an existing baseline again keeps its scenario and tolerance.
+        if (!budget.load(budgetFilename)) {
+            return 1;
+        }
+        if (!writeBudget && !budget.measured) {
+            std::cout << "Budget: SKIP, the baseline of this scenario was never recorded (see --write-budget)" << std::endl;
+            return FrameBudget::NotRecordedExitCode;
+        }
+        spawnerFilename = budget.spawnerFilename;
+        setSeed(budget.seed);
+        ticks = qMax(budget.ticks, qint64(1));
+        tickDuration = qMax(budget.tickDuration, qint64(1));
+    }
+
+    AssetPreloader::preloadBlocking();      // Sprites decoded in parallel, not on first spawn
+    MainScene scene(nullptr, 60, true);
+    scene.setBatchSteeringEnabled(batchSteering);
+    if (replayFilename != "") {
+        if (!scene.startReplay(replayFilename)) {
+            return 1;
+        }
+    }
+    else {
+        if (spawnerFilename != "") {
+            scene.setSpawner(spawnerFilename);
+        }
+        if (hasSeed) {
+            scene.setSeed(seed);
+        }
+        if (recordFilename != "" && !scene.startRecording(recordFilename)) {
+            return 1;
+        }
+    }
+
+    if (profileCsvFilename != "" && !scene.getProfiler()->startCsv(profileCsvFilename)) {
+        return 1;
+    }
+
+    qsizetype peakEntities = scene.getEntityCount();
+    qint64 entityUpdates = 0;
+    qint64 heapBefore = AllocationCounter::getAllocations();
+    QList<qint64> heapWindow(PhaseHistogram::WindowSize, heapBefore);      // Heap allocations at the start of the last ticks
+    qint64 ticksDone = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    while (scene.isReplaying() || ticksDone < ticks) {
+        qint64 heapTickStart = AllocationCounter::getAllocations();
+        scene.step(tickDuration);
+        if (scene.isReplayFinished()) {
+            break;
+        }
+        heapWindow[ticksDone % PhaseHistogram::WindowSize] = heapTickStart;
+        ticksDone++;
+        entityUpdates += scene.getEntityCount();
+        peakEntities = qMax(peakEntities, scene.getEntityCount());
+        scene.getProfiler()->endFrame(scene.getEntityCount(), scene.getSceneTime());     // One frame per tick
+    }
+    scene.getProfiler()->stopCsv();
+    scene.stopRecording();
+
+    qint64 wallTime = timer.nsecsElapsed();
+    qreal wallSeconds = wallTime / 1e9;
+    qint64 heapAllocations = AllocationCounter::getAllocations() - heapBefore;
+    qint64 windowTicks = qMin(ticksDone, PhaseHistogram::WindowSize);
+    qint64 windowAllocations = AllocationCounter::getAllocations() - heapWindow[ticksDone % PhaseHistogram::WindowSize];
+
+    std::cout << "Ticks:           " << ticksDone << std::endl;
+    std::cout << "Seed:            " << scene.getSeed() << std::endl;
+    std::cout << "Simulated time:  " << scene.getSceneTime() << " ms" << std::endl;
+    std::cout << "Wall time:       " << wallTime / 1e6 << " ms" << std::endl;
+    std::cout << "Ticks/sec:       " << (wallSeconds > 0 ? ticksDone / wallSeconds : 0) << std::endl;
+    std::cout << "Entities:        " << scene.getEntityCount() << " (peak " << peakEntities << ")" << std::endl;
+    std::cout << "Tick p99:        " << scene.getProfiler()->getHistogram(ProfilePhases::Step).percentile(0.99) / 1e6 << " ms" << std::endl;
+    std::cout << "Peak RSS:        " << getPeakRss() << " kB" << std::endl;
+    if (AllocationCounter::isInstalled()) {
+        std::cout << "Heap allocs:     " << heapAllocations << " (" << (ticksDone > 0 ? qreal(heapAllocations) / ticksDone : 0)
+                  << " per tick), " << windowAllocations << " in the last " << windowTicks << " ticks" << std::endl;
+    }
+    std::cout << "Score:           " << scene.getScore() << std::endl;
+    std::cout << "State checksum:  " << std::hex << scene.getStateChecksum() << std::dec << std::endl;
+    std::cout << "Phases, last " << PhaseHistogram::WindowSize << " ticks (p50 / p99, us):" << std::endl;
+    for (int phase=0; phase<ProfilePhases::Render; phase++) {
+        const PhaseHistogram& histogram = scene.getProfiler()->getHistogram(ProfilePhases::Phase(phase));
+        std::cout << "  " << ProfilePhases::getName(ProfilePhases::Phase(phase)) << ": "
+                  << histogram.percentile(0.5) / 1000 << " / " << histogram.percentile(0.99) / 1000 << std::endl;
+    }
+    if (CostAccounting::isEnabled()) {
+        CostAccounting::print(std::cout);
+    }
+    std::cout << "Pools:" << std::endl;
+    printPoolStats("Missile   ", Pool<Missile>::getStats());
+    printPoolStats("Rocket    ", Pool<Rocket>::getStats());
+    printPoolStats("EffectZone", Pool<EffectZone>::getStats());
+    printPoolStats("Item      ", Pool<Item>::getStats());
+    printPoolStats("Sprite    ", Pool<Sprite>::getStats());
+    AssetManager::print(std::cout);
+
+    if (budgetFilename == "") {
+        return 0;
+    }
+
+    RunMetrics metrics;
+    metrics.meanTickMs = ticksDone > 0 ? wallTime / 1e6 / ticksDone : 0;
+    metrics.p99TickMs = scene.getProfiler()->getHistogram(ProfilePhases::Step).percentile(0.99) / 1e6;
+    metrics.allocationsPerTick = ticksDone > 0 ? qreal(heapAllocations) / ticksDone : 0;
+    metrics.entityThroughput = wallSeconds > 0 ? entityUpdates / wallSeconds : 0;
+    metrics.referenceMs = FrameBudget::measureReference();
+    if (!AllocationCounter::isInstalled()) {
+        qWarning() << "Heap allocations are not counted in this executable, the budget check is incomplete";
+    }
+
+    if (writeBudget) {
+        budget.spawnerFilename = spawnerFilename;
+        budget.seed = scene.getSeed();
+        budget.ticks = ticksDone;
+        budget.tickDuration = tickDuration;
+        budget.baseline = metrics;
+        return budget.save(budgetFilename) ? 0 : 1;
+    }
+    return budget.check(metrics, std::cout) ? 0 : 2;
+}
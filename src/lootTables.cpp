@@ -4,6 +4,7 @@
 #include <QJsonArray>
 #include <QDebug>
 #include "../include/lootTables.hpp"
+#include "../include/traceRecorder.hpp"
 
 #define LOOTTABLES_PATH "../res/loottables/"
 
@@ -14,13 +15,18 @@ LootTables::~LootTables() { }
 /**
  * Static method.
  * Generate loot tables. Automatically called when trying to access loot tables for the first time.
- * You can call this method to preprocess the generation.
+ * You can call this method to preprocess the generation. Does nothing if the tables already exist.
  * /!\ This class is not able to delete its own tables. Please call deleteTables() to avoid memory leaks
  */
 void LootTables::generateTables() {
+    if (loots != nullptr) {
+        return;
+    }
+    TraceSpan span("LootTables::generateTables", "load");
     // TODO: when adding a new loot table, the table should be added here to let the script know the table exists
     loots = new QMap<QString, QList<QString>*>();
     weights = new QMap<QString, std::discrete_distribution<>>();
+    weaponIds = new QMap<QString, QList<WeaponId>*>();
 
     addTable("common_mob.json");
     addTable("rare_mob.json");
@@ -86,10 +92,15 @@ void LootTables::deleteTables() {
     }
     delete weights;
     weights = nullptr;
+    if (weaponIds) {
+        qDeleteAll(*weaponIds);
+        delete weaponIds;
+        weaponIds = nullptr;
+    }
 }
 
 /**
- * Save distribution to the static maps
+ * Save distribution to the static maps, and resolve loots naming a weapon file to their WeaponId
  * 
  * @param tableName name of the table
  * @param newLoots Loots of the new table
@@ -101,6 +112,31 @@ void LootTables::saveDistribution(const QString& tableName, QList<QString>* newL
         tableName,
         std::discrete_distribution(newWeights->begin(), newWeights->end())
     );
+
+    // Weapon loots name a file of res/weapon (should look like "gun/foo.json"), item loots do not
+    QList<WeaponId>* newWeaponIds = new QList<WeaponId>();
+    for (const QString& loot : *newLoots) {
+        newWeaponIds->append(loot.endsWith(".json") ? WeaponRegistry::getId(loot) : WeaponRegistry::InvalidId);
+    }
+    weaponIds->insert(tableName, newWeaponIds);
+}
+
+/**
+ * Draw the index of a random loot of a table. Always draws, so that the random sequence
+ * does not depend on which tables exist.
+ * 
+ * @param lootTable Loot table to draw from (should look like "foo.json")
+ * @return Index of the loot in the table, -1 if the table is unknown
+ */
+qsizetype LootTables::drawIndex(const QString& lootTable) {
+    // Randomness solution comes from:
+    // https://en.cppreference.com/w/cpp/numeric/random/discrete_distribution
+    int rdm_lootIndex = weights->value(lootTable)(mtGen);
+    if (!loots->contains(lootTable)) {
+        qWarning() << "Loot table " << lootTable << " is unknown LootTable loader.";
+        return -1;
+    }
+    return rdm_lootIndex;
 }
 
 /**
@@ -117,17 +153,35 @@ QString LootTables::getRandomLoot(const QString& lootTable) {
     if (lootTable == "") {
         return "Nothing";
     }
-    else {
-        // Randomness solution comes from:
-        // https://en.cppreference.com/w/cpp/numeric/random/discrete_distribution
-
-        int rdm_lootIndex = weights->value(lootTable)(mtGen);
-        if (loots->contains(lootTable)) {
-            return loots->value(lootTable)->at(rdm_lootIndex);
-        }
-        else {
-            qWarning() << "Loot table " << lootTable << " is unknown LootTable loader.";
-            return "";
-        }
+    qsizetype index = drawIndex(lootTable);
+    return index >= 0 ? loots->value(lootTable)->at(index) : "";
+}
+
+/**
+ * Static method.
+ * Get a random weapon from the given loot table. Same draw as getRandomLoot(), without looking up the weapon by name.
+ * 
+ * @param lootTable Weapon loot table to get the random weapon from (should look like "foo.json")
+ * @return Id of the weapon, to give to WeaponRegistry::create(). InvalidId if the loot is not a known weapon.
+ */
+WeaponId LootTables::getRandomWeapon(const QString& lootTable) {
+    if (! (weights || loots)) {
+        generateTables();
+    }
+
+    if (lootTable == "") {
+        return WeaponRegistry::InvalidId;
     }
-}
\ No newline at end of file
+    qsizetype index = drawIndex(lootTable);
+    return index >= 0 ? weaponIds->value(lootTable)->at(index) : WeaponRegistry::InvalidId;
+}
+
+/**
+ * Static method.
+ * Seed the random generator used by every loot table
+ * 
+ * @param seed The new seed
+ */
+void LootTables::setSeed(quint32 seed) {
+    mtGen.seed(seed);
+}
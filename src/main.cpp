@@ -14,6 +14,7 @@
 #include <QMouseEvent>
 #include <QTimer>
 #include <QAbstractButton>
+#include <QCommandLineParser>
 #include "../include/menu/mainWindow.hpp"
 #include "../include/mainScene.hpp"
 #include "../include/mainGraphicsView.hpp"
@@ -22,23 +23,101 @@
 #include "../include/mainScene.hpp"
 #include "../include/mainGraphicsView.hpp"
 #include "../include/entity/item.hpp"
+#include "../include/headlessRunner.hpp"
+#include "../include/traceRecorder.hpp"
+#include "../include/costAccounting.hpp"
+#include "../include/assetManager.hpp"
 
 
 int main(int argc, char *argv[]) {
+    // Headless runs must not need a display: pick the offscreen platform before Qt starts
+    for (int i=1; i<argc; i++) {
+        if (QString(argv[i]) == "--headless" && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication app(argc, argv);
-    
-    MainWindow mWindow;
-    mWindow.showMaximized();
 
-    // Show scene example
-    // MainScene scene;       // container for QGraphicsItems
+    // Command line options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("MALL");
+    parser.addHelpOption();
+    QCommandLineOption headlessOption("headless", "Run the simulation without window, as fast as possible.");
+    parser.addOption(headlessOption);
+    QCommandLineOption ticksOption("ticks", "Amount of simulation steps in headless mode.", "N", QString::number(HeadlessRunner::DefaultTicks));
+    parser.addOption(ticksOption);
+    QCommandLineOption tickDurationOption("tick-ms", "Simulated milliseconds per step in headless mode.", "ms", QString::number(HeadlessRunner::DefaultTickDuration));
+    parser.addOption(tickDurationOption);
+    QCommandLineOption spawnerOption("spawner", "Spawner file used in headless mode (e.g. level1.json).", "file");
+    parser.addOption(spawnerOption);
+    QCommandLineOption recordOption("record", "Record the seed, inputs and ticks of the session to a file.", "file");
+    parser.addOption(recordOption);
+    QCommandLineOption replayOption("replay", "Replay a recorded session, in headless or windowed mode.", "file");
+    parser.addOption(replayOption);
+    QCommandLineOption seedOption("seed", "Seed of the simulation random generators (headless mode).", "seed");
+    parser.addOption(seedOption);
+    QCommandLineOption profileCsvOption("profile-csv", "Write the duration of each game loop phase to a CSV file, one row per frame.", "file");
+    parser.addOption(profileCsvOption);
+    QCommandLineOption profileOverlayOption("profile-overlay", "Show the frame profiler overlay from the start (toggle with F3).");
+    parser.addOption(profileOverlayOption);
+    QCommandLineOption traceOption("trace", "Record simulation, loading and render spans to a Chrome trace file (about:tracing, Perfetto).", "file");
+    parser.addOption(traceOption);
+    QCommandLineOption costsOption("costs", "Attribute update, collision and paint time to each entity kind. Shown in the profiler overlay and printed at exit.");
+    parser.addOption(costsOption);
+    QCommandLineOption budgetOption("budget", "Headless: run the scenario of a baseline file and fail if it got slower than the baseline.", "file");
+    parser.addOption(budgetOption);
+    QCommandLineOption writeBudgetOption("write-budget", "Headless: save the run (spawner, seed, ticks and its costs) as a baseline file.", "file");
+    parser.addOption(writeBudgetOption);
+    QCommandLineOption noBatchSteeringOption("no-batch-steering", "Headless: move chasing mobs one by one instead of in one batched pass (same end state, to compare).");
+    parser.addOption(noBatchSteeringOption);
+    parser.process(app);
 
-    // MainGraphicsView view(&scene);         // Scrollable area
-    // view.setRenderHint(QPainter::Antialiasing);     // Use antialiasing when rendering
-  
-    // QTimer timer;
-    // QObject::connect(&timer, &QTimer::timeout, &scene, &QGraphicsScene::advance);
-    // timer.start(1000 / 33);     // 30 fps
+    // Started before anything is loaded, so that resource loading is traced too
+    if (parser.isSet(traceOption)) {
+        TraceRecorder::start(parser.value(traceOption));
+    }
+    CostAccounting::setEnabled(parser.isSet(costsOption));
+
+    if (parser.isSet(headlessOption)) {
+        // Never enters the event loop
+        HeadlessRunner runner(
+            parser.value(ticksOption).toLongLong(),
+            parser.value(tickDurationOption).toLongLong(),
+            parser.value(spawnerOption)
+        );
+        runner.setRecordFile(parser.value(recordOption));
+        runner.setReplayFile(parser.value(replayOption));
+        runner.setProfileCsvFile(parser.value(profileCsvOption));
+        if (parser.isSet(budgetOption)) {
+            runner.setBudgetFile(parser.value(budgetOption), false);
+        }
+        else if (parser.isSet(writeBudgetOption)) {
+            runner.setBudgetFile(parser.value(writeBudgetOption), true);
+        }
+        if (parser.isSet(seedOption)) {
+            runner.setSeed(parser.value(seedOption).toULongLong());
+        }
+        runner.setBatchSteeringEnabled(!parser.isSet(noBatchSteeringOption));
+        int result = runner.run();
+        AssetManager::clear();
+        TraceRecorder::stop();
+        return result;
+    }
+    
+    int result;
+    {
+        MainWindow mWindow;
+        mWindow.setSessionFiles(parser.value(recordOption), parser.value(replayOption));
+        mWindow.setProfiling(parser.value(profileCsvOption), parser.isSet(profileOverlayOption));
+        mWindow.showMaximized();
+        result = app.exec();
+    }   // Scene, entities and their weapons are destroyed before the assets they use
 
-    return app.exec();
+    AssetManager::clear();
+    TraceRecorder::stop();
+    if (CostAccounting::isEnabled()) {
+        CostAccounting::print(std::cout);
+    }
+    return result;
 };
\ No newline at end of file
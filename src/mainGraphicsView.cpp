@@ -1,10 +1,13 @@
 #include <QApplication>
 #include "../include/mainGraphicsView.hpp"
+#include "../include/frameProfiler.hpp"
+#include "../include/costAccounting.hpp"
 
 /**
  * Default constructor
  */
 MainGraphicsView::MainGraphicsView(MainScene* scene, QWidget* parent) : QGraphicsView(scene, parent) {
+    mainScene = scene;
     setRenderHint(QPainter::Antialiasing);     // Use antialiasing when rendering
 
     // Options
@@ -38,6 +41,11 @@ void MainGraphicsView::mouseMoveEvent(QMouseEvent* event) {
 void MainGraphicsView::centerOnPlayer(Player* player){
     QRectF rect = player->sceneBoundingRect();
     this->centerOn(rect.center());
+
+    // The overlay does not scroll with the scene, repaint it every tick
+    if (showProfiler) {
+        viewport()->update(profilerOverlayRect());
+    }
 }
 /**
  * Destructor
@@ -46,4 +54,123 @@ MainGraphicsView::~MainGraphicsView() { }
 
 void MainGraphicsView::wheelEvent(QWheelEvent *event) {
     event->ignore();  // Ignore the wheel event to prevent zooming or scrolling
+}
+
+/**
+ * Handle key press event. F3 toggles the profiler overlay, other keys go to the scene.
+ *
+ * @param event The key event
+ */
+void MainGraphicsView::keyPressEvent(QKeyEvent* event) {
+    if (event->key() == Qt::Key_F3 && !event->isAutoRepeat()) {
+        setProfilerShown(!showProfiler);
+        return;
+    }
+    QGraphicsView::keyPressEvent(event);
+}
+
+/**
+ * Paint the view, timed as the render phase of the profiler, then close the profiled frame
+ *
+ * @param event The paint event
+ */
+void MainGraphicsView::paintEvent(QPaintEvent* event) {
+    {
+        ProfileScope scope(mainScene->getProfiler(), ProfilePhases::Render);
+        QGraphicsView::paintEvent(event);
+    }
+    mainScene->endFrame();
+}
+
+// --- PROFILER OVERLAY ---
+
+/**
+ * Know whether the profiler overlay is drawn
+ *
+ * @return True if the overlay is drawn
+ */
+bool MainGraphicsView::isProfilerShown() const {
+    return showProfiler;
+}
+
+/**
+ * Show or hide the profiler overlay
+ *
+ * @param show True to draw the overlay
+ */
+void MainGraphicsView::setProfilerShown(bool show) {
+    showProfiler = show;
+    viewport()->update(profilerOverlayRect());
+}
+
+/**
+ * Get the area of the viewport covered by the profiler overlay
+ *
+ * @return Overlay rect, in viewport coordinates
+ */
+QRect MainGraphicsView::profilerOverlayRect() const {
+    int lineHeight = QFontMetrics(font()).height();
+    int lines = ProfilePhases::Count + 2;
+    int width = ProfilerOverlayWidth;
+    if (CostAccounting::isEnabled()) {
+        lines += EntityKinds::Count;    // Header, then every kind but None
+        width = CostOverlayWidth;
+    }
+    return QRect(0, 0, width, lineHeight * lines + 8);
+}
+
+/**
+ * Draw the profiler overlay above the scene: p50 and p99 of each phase over the last ticks,
+ * then the cost of each entity kind over the last second if cost accounting is on
+ *
+ * @param painter Painter of the viewport
+ * @param rect Exposed area, in scene coordinates
+ */
+void MainGraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
+    QGraphicsView::drawForeground(painter, rect);
+    FrameProfiler* profiler = mainScene->getProfiler();
+    if (!showProfiler || profiler == nullptr) {
+        return;
+    }
+
+    // Draw in viewport coordinates so that the overlay stays in the corner
+    painter->save();
+    painter->resetTransform();
+
+    QRect overlay = profilerOverlayRect();
+    int lineHeight = QFontMetrics(font()).height();
+    painter->fillRect(overlay, QColor(0, 0, 0, 160));
+    painter->setPen(Qt::white);
+
+    int y = 4 + lineHeight;
+    painter->drawText(6, y, "phase          p50 / p99 (ms)");
+    for (int i=0; i<ProfilePhases::Count; i++) {
+        ProfilePhases::Phase phase = ProfilePhases::Phase(i);
+        const PhaseHistogram& histogram = profiler->getHistogram(phase);
+        y += lineHeight;
+        painter->drawText(6, y, QString("%1 %2 / %3")
+                          .arg(QString::fromLatin1(ProfilePhases::getName(phase)), -14)
+                          .arg(histogram.percentile(0.5) / 1e6, 0, 'f', 2)
+                          .arg(histogram.percentile(0.99) / 1e6, 0, 'f', 2));
+    }
+    y += lineHeight;
+    painter->drawText(6, y, QString("entities       %1").arg(profiler->getLastEntityCount()));
+
+    if (CostAccounting::isEnabled()) {
+        y += lineHeight;
+        painter->drawText(6, y, "kind           update / collide / paint (ms/s, calls/s)");
+        for (int i=EntityKinds::None+1; i<EntityKinds::Count; i++) {
+            EntityKinds::EntityKind kind = EntityKinds::EntityKind(i);
+            QString line = QString("%1").arg(QString::fromLatin1(EntityKinds::getName(kind)), -14);
+            for (int activity=0; activity<CostActivities::Count; activity++) {
+                line += QString(" %1 (%2)")
+                        .arg(CostAccounting::getTimeRate(CostActivities::Activity(activity), kind) / 1e6, 0, 'f', 2)
+                        .arg(CostAccounting::getCallRate(CostActivities::Activity(activity), kind), 0, 'f', 0);
+            }
+            y += lineHeight;
+            painter->drawText(6, y, line);
+        }
+    }
+
+    painter->restore();
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
+#include <QtConcurrent>
 #include "../include/entity/item.hpp"
 #include "../include/entity/player.hpp"
 #include "../include/entity/mob.hpp"
 #include "../include/weapon/gun.hpp"
 #include "../include/mainScene.hpp"
 #include "../include/lootTables.hpp"
+#include "../include/spriteNames.hpp"
+#include "../include/assetManager.hpp"
+#include "../include/traceRecorder.hpp"
+#include "../include/costAccounting.hpp"
+#include <QRandomGenerator>
 
 #define PLAYER_MAX_LIFE 200
 #define PLAYER_MAX_ENERGY 500
@@ -16,18 +22,29 @@
 
 /**
  * Default constructor.
+ * 
+ * @param parent Parent object
+ * @param fps Frame rate of the game loop timer
+ * @param headless If true, no timer is started: the world only advances through step()
  */
-MainScene::MainScene(QObject* parent, int fps) : QGraphicsScene(parent) {
+MainScene::MainScene(QObject* parent, int fps, bool headless) : QGraphicsScene(parent), headless(headless) {
+    EntityStore::attachScene(this);     // Entity rows are global: one scene at a time
+
     // Scene options
     setSceneRect(-50000, -50000, 100000, 100000);       // Scene size
     setFocus();
-    setItemIndexMethod(QGraphicsScene::NoIndex);      // Collision detection method : linear
+    setItemIndexMethod(QGraphicsScene::NoIndex);      // Collisions are handled by spatialHash, not by the scene index
     entities = new QList<Entity*>();
+    spatialHash = new SpatialHash();
+    mobSteering = new MobSteering();
+    profiler = new FrameProfiler();
+    seed = QRandomGenerator::global()->generate64();
     setSpawner("level1.json");
 
     // Generate caches
     Item::generateCache();
     LootTables::generateTables();
+    setSeed(seed);
     
     // Initialize player
     Player* pl = new Player(
@@ -37,7 +54,7 @@ MainScene::MainScene(QObject* parent, int fps) : QGraphicsScene(parent) {
         PLAYER_SPEED,
         PLAYER_BASE_POS,
         PLAYER_DIMS,
-        "player.png",
+        SpriteNames::Player,
         Teams::Player
     );
     pl->grabWeapon(Weapon::create("gun/blue_laser_pistol.json"), Inventory::WeaponSlot_1);
@@ -49,10 +66,12 @@ MainScene::MainScene(QObject* parent, int fps) : QGraphicsScene(parent) {
     // Activate game loop
     sceneTime = 0;
     deltaTime = (qint64) (1000/fps);
-    gameTimer = new QTimer(this);
-    connect(gameTimer, &QTimer::timeout, this, &MainScene::gameLoop);
+    if (!headless) {
+        gameTimer = new QTimer(this);
+        connect(gameTimer, &QTimer::timeout, this, &MainScene::gameLoop);
 
-    gameTimer->start(deltaTime);
+        gameTimer->start(deltaTime);
+    }
 
     deltaTimer.start();
     lastFrameTime = deltaTimer.elapsed();
@@ -66,10 +85,17 @@ MainScene::~MainScene() {
         delete entity;
     }
     delete entities;
-    disconnect(gameTimer, nullptr, nullptr, nullptr);       // Delete timer signal
-    delete gameTimer;
+    EntityStore::detachScene(this);
+    delete spatialHash;
+    delete mobSteering;
+    delete profiler;
+    if (gameTimer) {
+        disconnect(gameTimer, nullptr, nullptr, nullptr);       // Delete timer signal
+        delete gameTimer;
+    }
+    delete recorder;    // Writes the last records
+    delete replay;
     delete mobSpawner;
-    Item::deleteCache();      // Delete the cache (should occur automatically, but we delete it just in case)
     LootTables::deleteTables();
 }
 
@@ -81,18 +107,52 @@ MainScene::~MainScene() {
  * @param entity The entity to add to the scene
  */
 void MainScene::addEntity(Entity* entity) {
-    addItem(entity);
+    if (!headless) {
+        addItem(entity);    // Nothing is rendered in headless mode
+    }
     entities->append(entity);
+    entity->updateCollisionLayer();
+    spatialHash->insert(entity);
+    EntityStore::activate(entity);
+
+    // Spawned entities start their interpolation from their spawn position
+    entity->snapshotPosition();
+    entity->interpolateRender(1);
 }
 
 /**
  * Triggers onCollide(Entity* other) on each colliding Entity
+ * Candidate pairs come from the spatial hash, filtered by collision layers, then shapes are tested for each pair
  */
 void MainScene::checkCollisions() {
-    for (Entity* entity : *entities) {
-        for (QGraphicsItem* graphicsItem : entity->collidingItems()) {
-            if (Entity* otherEntity = dynamic_cast<Entity*>(graphicsItem)) {
+    if (!useSpatialHash) {
+        checkCollisionsLinear();
+        return;
+    }
+
+    collisionPairs.clear();     // Keeps capacity: no allocation once the list has grown
+    spatialHash->findPairs(&collisionPairs);
+
+    for (const QPair<Entity*, Entity*>& pair : collisionPairs) {
+        if (pair.first->collidesWithEntity(pair.second)) {
+            pair.first->onCollide(pair.second, deltaTime);
+            pair.second->onCollide(pair.first, deltaTime);
+        }
+    }
+}
+
+/**
+ * Triggers onCollide(Entity* other) on each colliding Entity
+ * Tests every entity against every other one. Kept as a reference for benchmarks.
+ */
+void MainScene::checkCollisionsLinear() {
+    for (qsizetype i=0; i<entities->size(); i++) {
+        Entity* entity = entities->at(i);
+        for (qsizetype j=i+1; j<entities->size(); j++) {
+            Entity* otherEntity = entities->at(j);
+            if (entity->canCollideWith(otherEntity) && entity->collidesWithEntity(otherEntity)) {
                 entity->onCollide(otherEntity, deltaTime);
+                otherEntity->onCollide(entity, deltaTime);
             }
         }
     }
@@ -100,39 +160,195 @@ void MainScene::checkCollisions() {
 
 /**
  * Triggers onUpdate() on each Entity
+ * Entities spawned during the update are updated in the same tick, in a following round.
  */
 void MainScene::updateEntities() {
-    for (qint64 i=0; i<entities->size(); i++) {
-        Entity* entity =entities->at(i);
-        
-        if (entity->onUpdate(deltaTime)) {      // Update entity. True if entity wants to spawn another entity
-
-            // Spawn new entities while current entity in loop wants to spawn entities
-            Entity* newEntity = entity->getSpawned();
-            while (newEntity != nullptr) {
-                addEntity(newEntity);
-                newEntity = entity->getSpawned();
+    movedMissileRows = 0;
+    qsizetype begin = 0;
+    while (begin < entities->size()) {
+        qsizetype end = entities->size();
+        updateRange(begin, end);
+        begin = end;
+    }
+}
+
+/**
+ * Update a range of entities, then spawn what they asked for.
+ * Entities that only touch their own state are updated last, by the thread pool if enabled;
+ * the others, and every spawn, are handled on the main thread first.
+ * 
+ * @param begin Index of the first entity to update
+ * @param end Index after the last entity to update
+ */
+void MainScene::updateRange(qsizetype begin, qsizetype end) {
+    serialBatch.clear();
+    parallelBatch.clear();
+    spawners.clear();
+
+    for (qsizetype i=begin; i<end; i++) {
+        Entity* entity = entities->at(i);
+        if (entity->canUpdateInParallel()) {
+            parallelBatch.append(entity);
+        }
+        else {
+            serialBatch.append(entity);
+        }
+    }
+
+    // Player and items first: mobs read the position of their target during their update
+    updateSlice(serialBatch, 0, serialBatch.size(), &spawners);
+
+    // Chasing mobs move in one pass once their target has moved, before their own update
+    if (useBatchSteering) {
+        TraceSpan span("mob_steering", "update");
+        mobSteering->steer(parallelBatch, deltaTime);
+    }
+
+    // Missiles fly in one pass over the store, before their own update checks their range
+    {
+        TraceSpan span("missile_motion", "update");
+        movedMissileRows = EntityStore::moveMissiles(movedMissileRows, deltaTime);
+    }
+
+    updateParallelBatch();
+
+    // Spawn new entities while each entity wants to spawn entities
+    for (Entity* entity : spawners) {
+        Entity* newEntity = entity->getSpawned();
+        while (newEntity != nullptr) {
+            addEntity(newEntity);
+            newEntity = entity->getSpawned();
+        }
+    }
+}
+
+/**
+ * Update the parallel batch, on the thread pool if enabled.
+ * Each chunk records its spawn requests in its own buffer; buffers are merged in chunk order,
+ * so spawn order does not depend on thread scheduling.
+ */
+void MainScene::updateParallelBatch() {
+    qsizetype count = parallelBatch.size();
+    qsizetype chunkCount = (count + ParallelChunkSize - 1) / ParallelChunkSize;
+
+    // Not worth waking up the pool for a single chunk
+    if (!useParallelUpdate || chunkCount <= 1) {
+        updateSlice(parallelBatch, 0, count, &spawners);
+        return;
+    }
+
+    updateChunks.resize(chunkCount);
+    for (qsizetype i=0; i<chunkCount; i++) {
+        updateChunks[i].begin = i*ParallelChunkSize;
+        updateChunks[i].end = qMin(count, (i+1)*ParallelChunkSize);
+        updateChunks[i].spawners.clear();
+    }
+
+    // Moving entities must not touch the shared grid from workers
+    spatialHash->setDeferred(true);
+    QtConcurrent::blockingMap(updateChunks, [this](UpdateChunk& chunk) {
+        updateSlice(parallelBatch, chunk.begin, chunk.end, &chunk.spawners);
+    });
+    spatialHash->setDeferred(false);
+    spatialHash->flush(parallelBatch);
+
+    for (const UpdateChunk& chunk : updateChunks) {
+        spawners.append(chunk.spawners);
+    }
+}
+
+/**
+ * Update part of a batch of entities.
+ * While tracing or accounting costs, each run of consecutive entities of the same kind is timed
+ * as a whole: it becomes one trace span and one cost record.
+ * 
+ * @param batch Entities to update
+ * @param begin Index of the first entity to update
+ * @param end Index after the last entity to update
+ * @param spawned List to append the entities that want to spawn another entity to
+ */
+void MainScene::updateSlice(const QList<Entity*>& batch, qsizetype begin, qsizetype end, QList<Entity*>* spawned) {
+    bool tracing = TraceRecorder::isEnabled();
+    bool accounting = CostAccounting::isEnabled();
+    if (!tracing && !accounting) {
+        for (qsizetype i=begin; i<end; i++) {
+            Entity* entity = batch.at(i);
+            if (entity->onUpdate(deltaTime)) {      // Update entity. True if entity wants to spawn another entity
+                spawned->append(entity);
             }
         }
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 traceOrigin = tracing ? TraceRecorder::now() : 0;
+    EntityKinds::EntityKind runKind = EntityKinds::None;
+    qsizetype runBegin = begin;
+    qint64 runStart = 0;
+
+    auto endRun = [&](qsizetype runEnd, qint64 now) {
+        if (tracing) {
+            TraceRecorder::addSpan(EntityKinds::getName(runKind), "update", traceOrigin + runStart, traceOrigin + now);
+        }
+        CostAccounting::add(CostActivities::Update, runKind, now - runStart, runEnd - runBegin);
+    };
+
+    for (qsizetype i=begin; i<end; i++) {
+        Entity* entity = batch.at(i);
+        if (entity->getKind() != runKind) {
+            qint64 now = timer.nsecsElapsed();
+            if (i > begin) {
+                endRun(i, now);
+            }
+            runKind = entity->getKind();
+            runBegin = i;
+            runStart = now;
+        }
+        if (entity->onUpdate(deltaTime)) {
+            spawned->append(entity);
+        }
+    }
+
+    if (end > begin) {
+        endRun(end, timer.nsecsElapsed());
     }
 }
 
 /**
  * Cleanup the scene from removed entities
+ * Single compacting pass: kept entities are shifted down in place, so order is preserved
+ * and removing many entities at once stays linear.
  */
 void MainScene::cleanupScene() {
-    for (qint64 i=0; i<entities->size(); i++) {
-        Entity* entity = entities->at(i);
+    Entity** data = entities->data();
+    qsizetype count = entities->size();
+    qsizetype kept = 0;
+
+    for (qsizetype i=0; i<count; i++) {
+        Entity* entity = data[i];
         if (entity->getDeleted()) {     // if entity has been removed
-            // If entity is a mob, add its score to global score
-            if (Mob* mob = dynamic_cast<Mob*>(entity)) {
-                gameScore += mob->getScoreValue();
-            }
-            entities->removeAt(i);       // remove the entity
+            deathEvents.append(DeathEvent { entity->getScoreValue() });
             delete entity;
-            i--;                        // Readjust i to avoid out of list bounds
+        }
+        else {
+            data[kept] = entity;
+            kept++;
         }
     }
+    entities->resize(kept);
+
+    processDeathEvents();
+}
+
+/**
+ * Apply the consequences of the deaths of this tick
+ */
+void MainScene::processDeathEvents() {
+    for (const DeathEvent& event : deathEvents) {
+        gameScore += event.scoreValue;
+    }
+    deathEvents.clear();
 }
 
 /**
@@ -149,22 +365,101 @@ void MainScene::spawnMobWave() {
 }
 
 /**
- * Main game loop. Triggered every frame.
+ * Move every rendered item between its positions of the last two ticks
+ * 
+ * @param alpha Interpolation factor, in [0; 1]
+ */
+void MainScene::interpolateEntities(qreal alpha) {
+    EntityStore::interpolateRender(alpha);
+}
+
+/**
+ * Main game loop. Triggered every frame by the game timer.
+ * Runs as many fixed ticks as the elapsed wall-clock time allows, then renders
+ * entities in between the last two ticks.
  */
 void MainScene::gameLoop() {
-    // Change delta time
-    sceneTime = deltaTimer.elapsed();
-    deltaTime = sceneTime - lastFrameTime;
-    lastFrameTime = sceneTime;
-
-    checkCollisions();
-    updateEntities();
-    cleanupScene();
-    spawnMobWave();
+    TraceSpan frameSpan("frame", "frame");
+    endFrame();     // Previous frame was not painted (hidden window, nothing changed)
+    qint64 frameTime = deltaTimer.elapsed();
+    tickAccumulator += frameTime - lastFrameTime;
+    lastFrameTime = frameTime;
+
+    int ticks = 0;
+    while (tickAccumulator >= TickDuration && ticks < MaxTicksPerFrame) {
+        step(TickDuration);
+        tickAccumulator -= TickDuration;
+        ticks++;
+    }
+    // After a long stall, drop the time that could not be simulated instead of catching up forever
+    if (tickAccumulator >= TickDuration) {
+        tickAccumulator = TickDuration - 1;
+    }
+
+    interpolateEntities(qreal(tickAccumulator) / TickDuration);
+    // A view closes the frame once it has painted it, so that the render time lands in the same row
+    framePending = true;
+    if (views().isEmpty()) {
+        endFrame();
+    }
     if(mainPlayer!=nullptr){
         emit playerMoved(getMainPlayer());
     }
-    
+}
+
+/**
+ * Close the frame simulated by the last gameLoop(), if it is not closed yet.
+ * Called by the view at the end of its paint.
+ */
+void MainScene::endFrame() {
+    if (framePending) {
+        framePending = false;
+        profiler->endFrame(entities->size(), sceneTime);
+    }
+}
+
+/**
+ * Advance the world by the given amount of time.
+ * Does not depend on any timer nor view: headless runs call it directly, as fast as possible.
+ * The game loop always calls it with TickDuration, so gameplay does not depend on frame rate.
+ * While replaying, the recorded duration is used instead.
+ * 
+ * @param deltaMs Simulated time to advance, in milliseconds
+ */
+void MainScene::step(qint64 deltaMs) {
+    if (replay) {
+        // Recorded inputs are applied at tick boundaries, with the recorded tick duration
+        deltaMs = replay->nextTick(mainPlayer);
+        if (deltaMs < 0) {
+            return;     // Session is over: the world stays as it was at the end of the recording
+        }
+    }
+    if (recorder) {
+        recorder->recordTick(deltaMs);
+    }
+
+    ProfileScope stepScope(profiler, ProfilePhases::Step);
+    deltaTime = deltaMs;
+    sceneTime += deltaMs;
+
+    EntityStore::snapshotPositions();
+
+    {
+        ProfileScope scope(profiler, ProfilePhases::Collisions);
+        checkCollisions();
+    }
+    {
+        ProfileScope scope(profiler, ProfilePhases::Update);
+        updateEntities();
+    }
+    {
+        ProfileScope scope(profiler, ProfilePhases::Cleanup);
+        cleanupScene();
+    }
+    {
+        ProfileScope scope(profiler, ProfilePhases::Spawn);
+        spawnMobWave();
+    }
 
     if (mainPlayer && mainPlayer->getIsDead()) {
         // TODO: react to player death. Use gameScore to get the total score of the game
@@ -179,6 +474,157 @@ void MainScene::gameLoop() {
 void MainScene::setSpawner(const QString& spawnerFilename) {
     delete mobSpawner;
     mobSpawner = new MobSpawner(spawnerFilename);
+    mobSpawner->setSeed(quint32(seed));
+    this->spawnerFilename = spawnerFilename;
+}
+
+/**
+ * Get the seed of the random generators of the simulation
+ * 
+ * @return The seed
+ */
+quint64 MainScene::getSeed() const {
+    return seed;
+}
+
+/**
+ * Seed every random generator of the simulation: mob spawn angles and loot tables.
+ * Two scenes with the same seed, spawner and inputs evolve identically.
+ * 
+ * @param newSeed The new seed
+ */
+void MainScene::setSeed(quint64 newSeed) {
+    seed = newSeed;
+    mobSpawner->setSeed(quint32(seed));
+    LootTables::setSeed(quint32(seed >> 32));
+}
+
+// --- RECORD/REPLAY ---
+
+/**
+ * Start writing the seed, player actions and ticks of this scene to a file
+ * 
+ * @param filename File to write the session to
+ * @return True if recording started
+ */
+bool MainScene::startRecording(const QString& filename) {
+    if (sceneTime != 0 || replay) {
+        qWarning() << "Recording must start before the first tick, and not during a replay";
+        return false;
+    }
+
+    delete recorder;
+    recorder = new SessionRecorder(filename, seed, spawnerFilename);
+    if (!recorder->isOpen()) {
+        delete recorder;
+        recorder = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Stop recording and close the session file
+ */
+void MainScene::stopRecording() {
+    delete recorder;
+    recorder = nullptr;
+}
+
+/**
+ * Replay a recorded session. Live inputs are ignored until the end of the session.
+ * Does not depend on the hash seed of the process: collisions are handled in a fixed order (see SpatialHash::findPairs()).
+ * 
+ * @param filename File written by startRecording()
+ * @return True if the replay started
+ */
+bool MainScene::startReplay(const QString& filename) {
+    if (sceneTime != 0 || recorder) {
+        qWarning() << "Replay must start before the first tick, and not while recording";
+        return false;
+    }
+
+    SessionReplay* newReplay = new SessionReplay(filename);
+    if (!newReplay->isValid()) {
+        delete newReplay;
+        return false;
+    }
+
+    delete replay;
+    replay = newReplay;
+    setSpawner(replay->getSpawnerFilename());
+    setSeed(replay->getSeed());
+    return true;
+}
+
+/**
+ * Know whether this scene is driven by a recorded session
+ * 
+ * @return True while replaying, even once the session is over
+ */
+bool MainScene::isReplaying() const {
+    return replay != nullptr;
+}
+
+/**
+ * Know whether every tick of the replayed session has been simulated
+ * 
+ * @return True if a replay is over
+ */
+bool MainScene::isReplayFinished() const {
+    return replay && replay->isFinished();
+}
+
+/**
+ * Apply an action to the controlled player, and record it if recording
+ * 
+ * @param action The action
+ */
+void MainScene::applyPlayerAction(const PlayerAction& action) {
+    if (!mainPlayer) {
+        return;
+    }
+    if (recorder) {
+        recorder->recordAction(action);
+    }
+    mainPlayer->applyAction(action);
+}
+
+/**
+ * Set the size of the collision grid cells
+ * Should be around the size of the most common entities
+ * 
+ * @param cellSize Width and height of a cell, in scene units
+ */
+void MainScene::setCollisionCellSize(qreal cellSize) {
+    spatialHash->setCellSize(cellSize);
+}
+
+/**
+ * Choose between the spatial hash and the linear collision check
+ * 
+ * @param enabled True to use the spatial hash, false to test every pair of entities
+ */
+void MainScene::setSpatialHashEnabled(bool enabled) {
+    useSpatialHash = enabled;
+}
+
+/**
+ * Choose between updating entities on the thread pool or only on the main thread
+ * 
+ * @param enabled True to update independent entities in parallel
+ */
+void MainScene::setParallelUpdateEnabled(bool enabled) {
+    useParallelUpdate = enabled;
+}
+
+/**
+ * Choose between moving chasing mobs in one batched pass or one by one in their update
+ * 
+ * @param enabled True to steer mobs in batch
+ */
+void MainScene::setBatchSteeringEnabled(bool enabled) {
+    useBatchSteering = enabled;
 }
 
 /**
@@ -193,13 +639,13 @@ void MainScene::setControlledPlayer(Player* player) {
  * Handle mouse press event
  */
 void MainScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
-    if (mainPlayer) {
+    if (mainPlayer && !replay) {
         switch (event->button()) {
             case Qt::LeftButton:
                 // Player action: player is now using weapon
-                QPointF mousePos = event->scenePos();
-                mainPlayer->actionSetUsingWeapon(true);
-                mainPlayer->actionSetTargetDirection(Vector2(mousePos) - mainPlayer->getCenterPos());
+                Vector2 direction = Vector2(event->scenePos()) - mainPlayer->getCenterPos();
+                applyPlayerAction(PlayerAction { PlayerActions::UsingWeapon, 1 });
+                applyPlayerAction(PlayerAction { PlayerActions::TargetDirection, direction.getX(), direction.getY() });
                 break;
         }
     }
@@ -211,11 +657,11 @@ void MainScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
  * Handle mouse release event
  */
 void MainScene::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
-    if (mainPlayer) {
+    if (mainPlayer && !replay) {
         switch (event->button()) {
             case Qt::LeftButton:
                 // Player action: player is no longer using weapon
-                mainPlayer->actionSetUsingWeapon(false);
+                applyPlayerAction(PlayerAction { PlayerActions::UsingWeapon, 0 });
                 break;
         }
     }
@@ -227,9 +673,9 @@ void MainScene::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
  * Handle mouse move event
  */
 void MainScene::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
-    if (mainPlayer) {
-        QPointF mousePos = event->scenePos();
-        mainPlayer->actionSetTargetDirection(Vector2(mousePos) - mainPlayer->getCenterPos());
+    if (mainPlayer && !replay) {
+        Vector2 direction = Vector2(event->scenePos()) - mainPlayer->getCenterPos();
+        applyPlayerAction(PlayerAction { PlayerActions::TargetDirection, direction.getX(), direction.getY() });
     }
 }
 
@@ -237,29 +683,31 @@ void MainScene::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
  * Handle key press event
  */
 void MainScene::keyPressEvent(QKeyEvent* event) {
-    switch (event->key()) {
-        case Qt::Key_Left:
-        case Qt::Key_Q:
-            mainPlayer->actionSetLeftMovement(1);
-            break;
-        case Qt::Key_Right:
-        case Qt::Key_D:
-            mainPlayer->actionSetRightMovement(1);
-            break;
-        case Qt::Key_Up:
-        case Qt::Key_Z:
-            mainPlayer->actionSetUpMovement(1);
-            break;
-        case Qt::Key_Down:
-        case Qt::Key_S:
-            mainPlayer->actionSetDownMovement(1);
-            break;
-        case Qt::Key_E:
-            mainPlayer->actionSetGrabPress(true);
-            break;
-        case Qt::Key_A:
-            mainPlayer->actionChangeWeapon();
-            break;
+    if (!replay) {
+        switch (event->key()) {
+            case Qt::Key_Left:
+            case Qt::Key_Q:
+                applyPlayerAction(PlayerAction { PlayerActions::LeftMovement, 1 });
+                break;
+            case Qt::Key_Right:
+            case Qt::Key_D:
+                applyPlayerAction(PlayerAction { PlayerActions::RightMovement, 1 });
+                break;
+            case Qt::Key_Up:
+            case Qt::Key_Z:
+                applyPlayerAction(PlayerAction { PlayerActions::UpMovement, 1 });
+                break;
+            case Qt::Key_Down:
+            case Qt::Key_S:
+                applyPlayerAction(PlayerAction { PlayerActions::DownMovement, 1 });
+                break;
+            case Qt::Key_E:
+                applyPlayerAction(PlayerAction { PlayerActions::GrabPress, 1 });
+                break;
+            case Qt::Key_A:
+                applyPlayerAction(PlayerAction { PlayerActions::ChangeWeapon });
+                break;
+        }
     }
 
     QGraphicsScene::keyPressEvent(event);
@@ -269,26 +717,28 @@ void MainScene::keyPressEvent(QKeyEvent* event) {
  * Handle key release event
  */
 void MainScene::keyReleaseEvent(QKeyEvent* event) {
-    switch (event->key()) {
-        case Qt::Key_Left:
-        case Qt::Key_Q:
-            mainPlayer->actionSetLeftMovement(0);
-            break;
-        case Qt::Key_Right:
-        case Qt::Key_D:
-            mainPlayer->actionSetRightMovement(0);
-            break;
-        case Qt::Key_Up:
-        case Qt::Key_Z:
-            mainPlayer->actionSetUpMovement(0);
-            break;
-        case Qt::Key_Down:
-        case Qt::Key_S:
-            mainPlayer->actionSetDownMovement(0);
-            break;
-        case Qt::Key_E:
-            mainPlayer->actionSetGrabPress(false);
-            break;
+    if (!replay) {
+        switch (event->key()) {
+            case Qt::Key_Left:
+            case Qt::Key_Q:
+                applyPlayerAction(PlayerAction { PlayerActions::LeftMovement, 0 });
+                break;
+            case Qt::Key_Right:
+            case Qt::Key_D:
+                applyPlayerAction(PlayerAction { PlayerActions::RightMovement, 0 });
+                break;
+            case Qt::Key_Up:
+            case Qt::Key_Z:
+                applyPlayerAction(PlayerAction { PlayerActions::UpMovement, 0 });
+                break;
+            case Qt::Key_Down:
+            case Qt::Key_S:
+                applyPlayerAction(PlayerAction { PlayerActions::DownMovement, 0 });
+                break;
+            case Qt::Key_E:
+                applyPlayerAction(PlayerAction { PlayerActions::GrabPress, 0 });
+                break;
+        }
     }
 
     QGraphicsScene::keyReleaseEvent(event);
@@ -303,8 +753,85 @@ Player* MainScene::getMainPlayer() {
     return mainPlayer;
 }
 
-void MainScene::setBackgroundTile(const QString &image_path){
-    this->m_tileImage = QPixmap(image_path);
+/**
+ * Get the amount of entities currently alive in the scene
+ * 
+ * @return Amount of entities
+ */
+qsizetype MainScene::getEntityCount() const {
+    return entities->size();
+}
+
+/**
+ * Get the total score of the game
+ * 
+ * @return The score
+ */
+qint64 MainScene::getScore() const {
+    return gameScore;
+}
+
+/**
+ * Get the profiler timing the phases of this scene
+ * 
+ * @return The profiler
+ */
+FrameProfiler* MainScene::getProfiler() const {
+    return profiler;
+}
+
+/**
+ * Get the time passed since start of scene
+ * 
+ * @return Scene time, in milliseconds
+ */
+qint64 MainScene::getSceneTime() const {
+    return sceneTime;
+}
+
+/**
+ * Get a checksum of the simulation state: scene time, score, and position of every entity.
+ * Two runs of the same session must end with the same checksum.
+ * 
+ * @return FNV-1a hash of the state
+ */
+quint64 MainScene::getStateChecksum() const {
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i=0; i<size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+
+    mix(&sceneTime, sizeof(sceneTime));
+    mix(&gameScore, sizeof(gameScore));
+    for (const Entity* entity : *entities) {
+        double x = entity->getPos().getX();
+        double y = entity->getPos().getY();
+        mix(&x, sizeof(x));
+        mix(&y, sizeof(y));
+    }
+    return hash;
+}
+
+/**
+ * Know whether this scene runs without timer nor rendering
+ * 
+ * @return Whether this scene is headless
+ */
+bool MainScene::isHeadless() const {
+    return headless;
+}
+
+/**
+ * Set the image tiled behind the entities. It is kept by the AssetManager, within its memory budget.
+ * 
+ * @param fileName Name of image file located in res/img (should look like "foo.png")
+ */
+void MainScene::setBackgroundTile(const QString& fileName) {
+    AtlasRegion region = AssetManager::getImage(fileName);
+    m_tileImage = region.page ? QPixmap::fromImage(region.page->copy(region.rect)) : QPixmap();
 }
 
 void MainScene::drawBackground(QPainter *painter, const QRectF &rect) {
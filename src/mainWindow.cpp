@@ -22,6 +22,7 @@
 #include <QGraphicsScene>
 #include <QDebug>
 #include "../include/entity/item.hpp"
+#include "../include/assetPreloader.hpp"
 
 
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent){
@@ -58,6 +59,11 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent){
     buttonLayout->addWidget(scoreBoard);
     buttonLayout->addWidget(quitGame);
 
+    this->loadingBar = new QProgressBar(mainMenu);
+    loadingBar->setFormat("Chargement... %v/%m");
+    loadingBar->hide();
+    buttonLayout->addWidget(loadingBar);
+
     logoWidget->setLayout(logoLayout);
     pseudoWidget->setLayout(pseudoLayout);
     buttonWidget->setLayout(buttonLayout);
@@ -91,16 +97,43 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent){
         *this->heroName = pseudoInput->text();
         qDebug() << *this->heroName;
 
-        scene = new MainScene(this, 60);
-        scene->setBackgroundTile("../res/img/background2.png");
-        newGameClicked(scene);
-        scene->setFocus();
+        // The scene starts once every sprite is decoded, see startGame()
+        newGame->setEnabled(false);
+        loadingBar->show();
+        preloader->start();
+    });
+
+    preloader = new AssetPreloader(this);
+    this->connect(preloader, &AssetPreloader::progress, this, [this](int done, int total){
+        loadingBar->setRange(0, total);
+        loadingBar->setValue(done);
     });
+    this->connect(preloader, &AssetPreloader::finished, this, &MainWindow::startGame);
 };
 
+/**
+ * Create and show the scene of a new game. Called once assets are preloaded.
+ */
+void MainWindow::startGame(){
+    scene = new MainScene(this, 60);
+    scene->setBackgroundTile("background2.png");
+    if (replayFilename != "") {
+        scene->startReplay(replayFilename);
+    }
+    else if (recordFilename != "") {
+        scene->startRecording(recordFilename);
+    }
+    if (profileCsvFilename != "") {
+        scene->getProfiler()->startCsv(profileCsvFilename);
+    }
+    newGameClicked(scene);
+    scene->setFocus();
+}
+
 void MainWindow::newGameClicked(MainScene *scene){
     view = new MainGraphicsView(scene);
     view->setRenderHint(QPainter::Antialiasing);
+    view->setProfilerShown(profileOverlay);
     QTimer timer;
     timer.start(1000 / 33);
     setCentralWidget(view);
@@ -118,4 +151,20 @@ QString* MainWindow::getHeroName(){
 
 void MainWindow::setHeroName(QString* name){
     this->heroName = name;
+}
+
+void MainWindow::setSessionFiles(const QString& recordFile, const QString& replayFile){
+    this->recordFilename = recordFile;
+    this->replayFilename = replayFile;
+}
+
+/**
+ * Set the profiling options of the next game
+ *
+ * @param csvFile File to write per-frame phase timings to, empty for none
+ * @param overlay Whether the profiler overlay is shown from the start
+ */
+void MainWindow::setProfiling(const QString& csvFile, bool overlay){
+    this->profileCsvFilename = csvFile;
+    this->profileOverlay = overlay;
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
-#include <QRandomGenerator>
 #include "../include/mobSpawner.hpp"
 #include "../include/entity/rangedMob.hpp"
+#include "../include/traceRecorder.hpp"
 
 #define SPAWNERINFO_PATH "../res/spawner/"
 
@@ -55,6 +55,7 @@ void MobSpawner::activateLoopReset() {
  * @param filename Name of Json file to load spawns from (should look like "foo.json")
  */
 void MobSpawner::createSpawnCache(const QString& filename) {
+    TraceSpan span("MobSpawner::createSpawnCache", "load");
     delete spawnList;   // Just in case of double calls
     spawnList = new QList<MobTrigger>();
 
@@ -111,6 +112,15 @@ bool MobSpawner::createSpawnList(const QJsonArray& array) {
     return true;
 }
 
+/**
+ * Seed the random generator of this spawner
+ * 
+ * @param seed The new seed
+ */
+void MobSpawner::setSeed(quint32 seed) {
+    random.seed(seed);
+}
+
 /**
  * Get the next mob to spawn. nullptr if no mob to spawn
  * 
@@ -146,7 +156,7 @@ Mob* MobSpawner::getSpawned(qint64 sceneTime, Player* target) {
         }
         Mob* newMob = mobs->value(mobName)->copy();
         if (target) {
-            qreal angle = QRandomGenerator64::global()->bounded(360.0);
+            qreal angle = random.bounded(360.0);
             Vector2 direction = Vector2::right.rotate(angle);
             newMob->setPos(target->getPos() + direction*spawnRange + target->getDims()/2 - newMob->getDims()/2);
             newMob->setTarget(target);
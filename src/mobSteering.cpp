@@ -0,0 +1,46 @@
+#include "../include/mobSteering.hpp"
+#include "../include/vector2Batch.hpp"
+#include "../include/entity/mob.hpp"
+
+/**
+ * Move the chasing mobs of a list of entities toward their target.
+ * Other entities, ranged mobs and mobs without target are left to their own update.
+ * Moved mobs skip the movement of their next onUpdate().
+ * 
+ * @param entities Entities to steer
+ * @param deltaTime Time elapsed since last tick, in milliseconds
+ */
+void MobSteering::steer(const QList<Entity*>& entities, qint64 deltaTime) {
+    mobs.clear();
+    positions.clear();
+    directions.clear();
+    stepLengths.clear();
+
+    // Gather
+    for (Entity* entity : entities) {
+        if (entity->getKind() != EntityKinds::Mob) {
+            continue;
+        }
+        Mob* mob = static_cast<Mob*>(entity);
+        const Player* target = mob->getTarget();
+        if (target == nullptr) {
+            continue;
+        }
+
+        mobs.append(mob);
+        positions.append(mob->getPos());
+        directions.append(target->getCenterPos() - mob->getCenterPos());
+        stepLengths.append(mob->getStepLength(deltaTime));
+    }
+
+    // Move
+    qsizetype count = mobs.size();
+    Vector2Batch::normalize(directions.data(), count);
+    Vector2Batch::addScaled(positions.data(), directions.constData(), stepLengths.constData(), count);
+
+    // Scatter
+    for (qsizetype i=0; i<count; i++) {
+        mobs.at(i)->setPos(positions.at(i));
+        mobs.at(i)->skipNextMove();
+    }
+}
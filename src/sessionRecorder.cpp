@@ -0,0 +1,110 @@
+#include <limits>
+#include <QDebug>
+#include "../include/sessionRecorder.hpp"
+
+// --- CONSTRUCTOR/DESTRUCTOR ---
+
+/**
+ * Constructor. Opens the file and writes the header.
+ * 
+ * @param filename File to write the session to
+ * @param seed Seed of the scene random generators
+ * @param spawnerFilename Spawner of the scene (should look like "foo.json")
+ */
+SessionRecorder::SessionRecorder(const QString& filename, quint64 seed, const QString& spawnerFilename) : file(filename) {
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open file" << filename;
+        return;
+    }
+
+    stream.setDevice(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << SessionFormat::Magic << SessionFormat::Version << seed << spawnerFilename;
+}
+
+/**
+ * Destructor. Writes the remaining ticks.
+ */
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+// --- GETTERS ---
+
+/**
+ * Know whether the session file could be opened
+ * 
+ * @return True if records are written
+ */
+bool SessionRecorder::isOpen() const {
+    return file.isOpen();
+}
+
+/**
+ * Get the amount of ticks recorded so far
+ * 
+ * @return Amount of ticks
+ */
+qint64 SessionRecorder::getRecordedTicks() const {
+    return recordedTicks;
+}
+
+// --- PRIVATE METHODS ---
+
+/**
+ * Write the ticks merged so far
+ */
+void SessionRecorder::flushTicks() {
+    if (pendingTicks > 0) {
+        stream << quint8(SessionFormat::Ticks) << quint32(pendingDelta) << pendingTicks;
+        pendingTicks = 0;
+    }
+}
+
+// --- METHODS ---
+
+/**
+ * Record a player action. It will be applied before the next recorded tick.
+ * 
+ * @param action The action
+ */
+void SessionRecorder::recordAction(const PlayerAction& action) {
+    if (!isOpen()) {
+        return;
+    }
+
+    flushTicks();
+    stream << quint8(SessionFormat::Action) << quint8(action.type) << double(action.x) << double(action.y);
+}
+
+/**
+ * Record a simulation tick
+ * 
+ * @param deltaMs Duration of the tick, in milliseconds (at most 2^32 - 1)
+ */
+void SessionRecorder::recordTick(qint64 deltaMs) {
+    if (!isOpen()) {
+        return;
+    }
+    if (deltaMs < 0 || deltaMs > qint64(std::numeric_limits<quint32>::max())) {
+        qWarning() << "Tick of" << deltaMs << "ms cannot be recorded, the replay will differ";
+        deltaMs = qBound(qint64(0), deltaMs, qint64(std::numeric_limits<quint32>::max()));
+    }
+
+    if (deltaMs != pendingDelta || pendingTicks == std::numeric_limits<quint32>::max()) {
+        flushTicks();
+        pendingDelta = deltaMs;
+    }
+    pendingTicks += 1;
+    recordedTicks += 1;
+}
+
+/**
+ * Write pending records and close the file
+ */
+void SessionRecorder::close() {
+    if (isOpen()) {
+        flushTicks();
+        file.close();
+    }
+}
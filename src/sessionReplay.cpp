@@ -0,0 +1,131 @@
+#include <QDebug>
+#include "../include/sessionReplay.hpp"
+#include "../include/entity/player.hpp"
+
+// --- CONSTRUCTOR/DESTRUCTOR ---
+
+/**
+ * Constructor. Opens the file and reads the header.
+ * 
+ * @param filename File written by SessionRecorder
+ */
+SessionReplay::SessionReplay(const QString& filename) : file(filename) {
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file" << filename;
+        finished = true;
+        return;
+    }
+
+    stream.setDevice(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    stream >> magic >> version;
+    if (magic != SessionFormat::Magic || version < SessionFormat::MinVersion || version > SessionFormat::Version) {
+        qWarning() << "Not a session file, or unsupported version:" << filename;
+        finished = true;
+        return;
+    }
+    stream >> seed >> spawnerFilename;
+    valid = stream.status() == QDataStream::Ok;
+    finished = !valid;
+}
+
+/**
+ * Destructor
+ */
+SessionReplay::~SessionReplay() { }
+
+// --- GETTERS ---
+
+/**
+ * Know whether the header could be read
+ * 
+ * @return True if the file is a session file
+ */
+bool SessionReplay::isValid() const {
+    return valid;
+}
+
+/**
+ * Know whether every recorded tick has been replayed
+ * 
+ * @return True if no tick is left
+ */
+bool SessionReplay::isFinished() const {
+    return finished;
+}
+
+/**
+ * Get the seed of the recorded scene
+ * 
+ * @return Seed of the scene random generators
+ */
+quint64 SessionReplay::getSeed() const {
+    return seed;
+}
+
+/**
+ * Get the spawner of the recorded scene
+ * 
+ * @return Spawner file name
+ */
+QString SessionReplay::getSpawnerFilename() const {
+    return spawnerFilename;
+}
+
+// --- METHODS ---
+
+/**
+ * Apply the actions recorded before the next tick, and get the duration of that tick
+ * 
+ * @param player Player receiving the actions
+ * @return Duration of the next tick, in milliseconds. -1 once the session is over.
+ */
+qint64 SessionReplay::nextTick(Player* player) {
+    while (remainingTicks == 0) {
+        if (finished || stream.atEnd()) {
+            finished = true;
+            return -1;
+        }
+
+        quint8 recordType = 0;
+        stream >> recordType;
+
+        if (recordType == SessionFormat::Ticks) {
+            if (version == 1) {
+                quint16 delta = 0;
+                stream >> delta >> remainingTicks;
+                currentDelta = delta;
+            }
+            else {
+                quint32 delta = 0;
+                stream >> delta >> remainingTicks;
+                currentDelta = delta;
+            }
+        }
+        else if (recordType == SessionFormat::Action) {
+            quint8 actionType = 0;
+            double x = 0;
+            double y = 0;
+            stream >> actionType >> x >> y;
+            if (player) {
+                player->applyAction(PlayerAction { PlayerActions::PlayerActionType(actionType), x, y });
+            }
+        }
+        else {
+            qWarning() << "Corrupted session file: unknown record" << recordType;
+            finished = true;
+            return -1;
+        }
+
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "Corrupted session file: truncated record";
+            finished = true;
+            return -1;
+        }
+    }
+
+    remainingTicks -= 1;
+    return currentDelta;
+}
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <cmath>
+#include <QDebug>
+#include "../include/spatialHash.hpp"
+#include "../include/entity/entity.hpp"
+
+// --- CELL RANGE ---
+
+/**
+ * Compare two cell ranges
+ *
+ * @param other Another cell range
+ * @return Whether both ranges cover the same cells
+ */
+bool SpatialHash::CellRange::operator==(const CellRange& other) const {
+    return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+}
+
+/**
+ * Compare two cell ranges
+ *
+ * @param other Another cell range
+ * @return Whether both ranges cover different cells
+ */
+bool SpatialHash::CellRange::operator!=(const CellRange& other) const {
+    return !(*this == other);
+}
+
+// --- CONSTRUCTOR/DESTRUCTOR ---
+
+/**
+ * Constructor
+ *
+ * @param cellSize Width and height of a cell, in scene units
+ */
+SpatialHash::SpatialHash(qreal cellSize) {
+    this->cellSize = cellSize > 0 ? cellSize : DefaultCellSize;
+}
+
+/**
+ * Destructor
+ */
+SpatialHash::~SpatialHash() {
+    clear();
+}
+
+// --- GETTERS/SETTERS ---
+
+/**
+ * Get the size of a cell
+ *
+ * @return Width and height of a cell, in scene units
+ */
+qreal SpatialHash::getCellSize() const {
+    return cellSize;
+}
+
+/**
+ * Change the size of cells. All registered entities are bucketed again.
+ *
+ * @param newCellSize New width and height of a cell (positive)
+ */
+void SpatialHash::setCellSize(qreal newCellSize) {
+    if (newCellSize <= 0) {
+        qWarning() << "Cell size must be positive";
+        return;
+    }
+
+    // Gather every registered entity once, then rebuild the grid
+    QList<Entity*> registered;
+    for (auto it = cells.cbegin(); it != cells.cend(); ++it) {
+        for (Entity* entity : it.value()) {
+            if (!registered.contains(entity)) {
+                registered.append(entity);
+            }
+        }
+    }
+
+    cells.clear();
+    cellSize = newCellSize;
+    for (Entity* entity : registered) {
+        entity->cellRange = computeRange(entity);
+        insertInCells(entity, entity->cellRange);
+    }
+}
+
+/**
+ * Know whether updates are currently deferred
+ *
+ * @return True if updates only mark entities as dirty
+ */
+bool SpatialHash::isDeferred() const {
+    return deferred;
+}
+
+/**
+ * Defer updates of the grid.
+ * While deferred, update() does not touch the cells and only marks the entity, so entities
+ * can move from several threads at once. Call flush() on the moved entities afterwards.
+ *
+ * @param defer True to defer updates, false to apply them immediately again
+ */
+void SpatialHash::setDeferred(bool defer) {
+    deferred = defer;
+}
+
+// --- PRIVATE METHODS ---
+
+/**
+ * Get the key of a cell from its coordinates
+ *
+ * @param x, y Coordinates of the cell
+ * @return Key of the cell in the cells map
+ */
+quint64 SpatialHash::cellKey(qint32 x, qint32 y) {
+    return (quint64(quint32(x)) << 32) | quint64(quint32(y));
+}
+
+/**
+ * Compute the cells covered by the bounding rect of an entity
+ *
+ * @param entity The entity
+ * @return Range of cells covered by the entity
+ */
+SpatialHash::CellRange SpatialHash::computeRange(const Entity* entity) const {
+    QRectF rect = entity->boundingRect().translated(entity->getPos().toPointF());
+    CellRange range;
+    range.minX = qint32(std::floor(rect.left() / cellSize));
+    range.minY = qint32(std::floor(rect.top() / cellSize));
+    range.maxX = qint32(std::floor(rect.right() / cellSize));
+    range.maxY = qint32(std::floor(rect.bottom() / cellSize));
+    return range;
+}
+
+/**
+ * Add an entity to every cell of the given range
+ *
+ * @param entity The entity to add
+ * @param range Cells to add the entity to
+ */
+void SpatialHash::insertInCells(Entity* entity, const CellRange& range) {
+    for (qint32 x = range.minX; x <= range.maxX; x++) {
+        for (qint32 y = range.minY; y <= range.maxY; y++) {
+            cells[cellKey(x, y)].append(entity);
+        }
+    }
+}
+
+/**
+ * Remove an entity from every cell of the given range
+ * Empty cells are dropped so that roaming entities do not grow the grid forever
+ *
+ * @param entity The entity to remove
+ * @param range Cells to remove the entity from
+ */
+void SpatialHash::removeFromCells(Entity* entity, const CellRange& range) {
+    for (qint32 x = range.minX; x <= range.maxX; x++) {
+        for (qint32 y = range.minY; y <= range.maxY; y++) {
+            auto it = cells.find(cellKey(x, y));
+            if (it != cells.end()) {
+                it.value().removeOne(entity);
+                if (it.value().isEmpty()) {
+                    cells.erase(it);
+                }
+            }
+        }
+    }
+}
+
+// --- METHODS ---
+
+/**
+ * Register an entity in the grid
+ *
+ * @param entity The entity to register
+ */
+void SpatialHash::insert(Entity* entity) {
+    if (entity->spatialHash == this) {
+        update(entity);
+        return;
+    }
+    else if (entity->spatialHash) {
+        entity->spatialHash->remove(entity);
+    }
+
+    entity->spatialHash = this;
+    entity->cellRange = computeRange(entity);
+    insertInCells(entity, entity->cellRange);
+}
+
+/**
+ * Move an entity to the cells matching its current position and bounds.
+ * Nothing happens while the entity stays in the same cells.
+ *
+ * @param entity The entity to update
+ */
+void SpatialHash::update(Entity* entity) {
+    if (deferred) {
+        entity->hashDirty = true;
+        return;
+    }
+
+    CellRange newRange = computeRange(entity);
+    if (newRange != entity->cellRange) {
+        removeFromCells(entity, entity->cellRange);
+        insertInCells(entity, newRange);
+        entity->cellRange = newRange;
+    }
+}
+
+/**
+ * Unregister an entity from the grid
+ *
+ * @param entity The entity to remove
+ */
+void SpatialHash::remove(Entity* entity) {
+    if (entity->spatialHash == this) {
+        removeFromCells(entity, entity->cellRange);
+        entity->spatialHash = nullptr;
+        entity->cellRange = CellRange();
+        entity->hashDirty = false;
+    }
+}
+
+/**
+ * Unregister every entity from the grid
+ */
+void SpatialHash::clear() {
+    for (auto it = cells.cbegin(); it != cells.cend(); ++it) {
+        for (Entity* entity : it.value()) {
+            entity->spatialHash = nullptr;
+            entity->cellRange = CellRange();
+        }
+    }
+    cells.clear();
+}
+
+/**
+ * Apply the updates deferred for the given entities
+ *
+ * @param entities Entities that may have moved while updates were deferred
+ */
+void SpatialHash::flush(const QList<Entity*>& entities) {
+    for (Entity* entity : entities) {
+        if (entity->hashDirty && entity->spatialHash == this) {
+            entity->hashDirty = false;
+            update(entity);
+        }
+    }
+}
+
+/**
+ * Get every pair of entities sharing at least one cell and whose collision layers interact.
+ * A pair spanning several cells is only reported by the first cell both entities cover,
+ * so each candidate pair appears exactly once.
+ * Pairs are sorted by the EntityStore rows of their entities: the order of cells in the hash
+ * depends on the hash seed of the process, and the order of collisions decides the game
+ * (which mob a missile hits first), so seeded runs and replays must not depend on it.
+ *
+ * @param pairs List to append the candidate pairs to
+ */
+void SpatialHash::findPairs(QList<QPair<Entity*, Entity*>>* pairs) const {
+    qsizetype firstPair = pairs->size();
+    for (auto it = cells.cbegin(); it != cells.cend(); ++it) {
+        const QList<Entity*>& bucket = it.value();
+        if (bucket.size() < 2) {
+            continue;
+        }
+
+        qint32 cellX = qint32(it.key() >> 32);
+        qint32 cellY = qint32(it.key() & 0xFFFFFFFF);
+
+        for (qsizetype i=0; i<bucket.size(); i++) {
+            Entity* first = bucket.at(i);
+            for (qsizetype j=i+1; j<bucket.size(); j++) {
+                Entity* second = bucket.at(j);
+                if (!first->canCollideWith(second)) {
+                    continue;
+                }
+
+                // Only the first shared cell reports the pair
+                qint32 sharedX = qMax(first->cellRange.minX, second->cellRange.minX);
+                qint32 sharedY = qMax(first->cellRange.minY, second->cellRange.minY);
+                if (sharedX == cellX && sharedY == cellY) {
+                    pairs->append(QPair<Entity*, Entity*>(first, second));
+                }
+            }
+        }
+    }
+
+    std::sort(pairs->begin() + firstPair, pairs->end(), [](const QPair<Entity*, Entity*>& a, const QPair<Entity*, Entity*>& b) {
+        if (a.first->storeRow != b.first->storeRow) {
+            return a.first->storeRow < b.first->storeRow;
+        }
+        return a.second->storeRow < b.second->storeRow;
+    });
+}
@@ -1,7 +1,7 @@
 #include <QtDebug>
+#include <QTransform>
 #include "../include/sprite.hpp"
-
-#define IMAGE_PATH "../res/img/"
+#include "../include/pool.hpp"
 
 // --- Constructor/destructor ---
 
@@ -11,12 +11,6 @@
  * @param img Image of the sprite
  */
 Sprite::Sprite() {
-    spritesCount += 1;
-
-    if (spritesCache == nullptr) {
-        initSpritesCache();
-    }
-
     setImage("");
 }
 
@@ -26,12 +20,6 @@ Sprite::Sprite() {
  * @param fileName File name of sprite (should look like: "foo.png")
  */
 Sprite::Sprite(const QString& fileName) {
-    spritesCount += 1;
-
-    if (spritesCache == nullptr) {
-        initSpritesCache();
-    }
-
     setImage(fileName);
 }
 
@@ -41,28 +29,59 @@ Sprite::Sprite(const QString& fileName) {
  * @param other Another sprite
  */
 Sprite::Sprite(const Sprite& other) {
-    spritesCount += 1;
-    this->image = other.image;
+    this->region = other.region;
 }
 
 /**
- * Destructor
+ * Destructor. Images stay in the AssetManager.
  */
-Sprite::~Sprite() {
-    spritesCount -= 1;
+Sprite::~Sprite() { }
 
-    if (spritesCount == 0) {
-        deleteCachedSprites();
-    }
+/**
+ * Allocate memory for a new sprite from the Sprite pool
+ * 
+ * @param size Size of the object
+ * @return Pointer to uninitialized memory
+ */
+void* Sprite::operator new(std::size_t size) {
+    return Pool<Sprite>::allocate(size);
+}
+
+/**
+ * Give the memory of a destroyed sprite back to the Sprite pool
+ * 
+ * @param ptr Memory of the object
+ * @param size Size of the object
+ */
+void Sprite::operator delete(void* ptr, std::size_t size) {
+    Pool<Sprite>::deallocate(ptr, size);
+}
+
+/**
+ * Know whether this sprite has nothing to draw
+ * 
+ * @return True if there is no image
+ */
+bool Sprite::isNull() const {
+    return region.page == nullptr;
+}
+
+/**
+ * Get a shared pointer to the atlas page holding the image
+ * 
+ * @return A shared pointer to the page, nullptr if there is no image
+ */
+QSharedPointer<QImage> Sprite::getPage() const {
+    return region.page;
 }
 
 /**
- * Get a shared pointer to the texture image
+ * Get where the image is in its atlas page
  * 
- * @return A shared pointer to the image
+ * @return Source rect of the image in the page
  */
-QSharedPointer<QImage> Sprite::getImage() const {
-    return image;
+QRect Sprite::getSourceRect() const {
+    return region.rect;
 }
 
 /**
@@ -71,31 +90,148 @@ QSharedPointer<QImage> Sprite::getImage() const {
  * @param fileName Name of image file located in res/img (should look like "foo.png")
  */
 void Sprite::setImage(const QString& fileName) {
-    // If the image is in cache, simply take it from cache
-    if (spritesCache->contains(fileName)) {
-        image = spritesCache->value(fileName);
+    region = AssetManager::getImage(fileName);
+}
+
+/**
+ * Get the image of this sprite scaled to a size, mirrored and rotated, doing it on first request
+ * 
+ * @param size Size in device pixels, before rotation
+ * @param pixelRatio Device pixel ratio the image is drawn with
+ * @param rotation Clockwise rotation in degrees, multiple of RotationStep
+ * @param mirrored True to flip the image horizontally
+ * @return Pixmap of the given size, grown to hold the rotated image
+ */
+QPixmap Sprite::getScaled(const QSize& size, qreal pixelRatio, int rotation, bool mirrored) const {
+    if (scaledCache == nullptr) {
+        scaledCache = new QCache<ScaledSpriteKey, QPixmap>(scaledBudget);
+    }
+
+    ScaledSpriteKey key { region.page->cacheKey(), region.rect, size, pixelRatio, rotation, mirrored };
+    if (QPixmap* cached = scaledCache->object(key)) {
+        return *cached;
+    }
+
+    // Same sampling as drawing the image directly into the rect
+    QImage scaled = region.page->copy(region.rect).scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    if (mirrored) {
+        scaled = scaled.mirrored(true, false);
     }
-    else {
-        // If the image is not in cache, create a new one and add it to cache
-        image = QSharedPointer<QImage>(new QImage(IMAGE_PATH + fileName));
-        spritesCache->insert(fileName, image);
+    if (rotation != 0) {
+        scaled = scaled.transformed(QTransform().rotate(rotation), Qt::SmoothTransformation);
     }
+    QPixmap pixmap = QPixmap::fromImage(scaled);
+    pixmap.setDevicePixelRatio(pixelRatio);
+    scaledCache->insert(key, new QPixmap(pixmap), getCost(pixmap));     // Evicts the least recently drawn ones if over budget
+    return pixmap;
 }
 
-// --- STATIC ---
+/**
+ * Draw the image of this sprite, stretched to a rect. Does nothing if there is no image.
+ * The image is scaled (and mirrored) once per size, then every draw is a plain pixmap blit.
+ * 
+ * @param painter Painter to draw on
+ * @param target Rect to draw the image in
+ * @param mirrored True to draw the image flipped horizontally, e.g. for entities looking left
+ */
+void Sprite::draw(QPainter* painter, const QRectF& target, bool mirrored) const {
+    if (region.page == nullptr) {
+        return;
+    }
+
+    qreal pixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1;
+    QSize size(qRound(target.width() * pixelRatio), qRound(target.height() * pixelRatio));
+    if (size.isEmpty()) {
+        return;
+    }
+    painter->drawPixmap(target.topLeft(), getScaled(size, pixelRatio, 0, mirrored));
+}
 
 /**
- * Initialize sprite cache
+ * Draw the image of this sprite stretched to a rect, then rotated around the center of the rect.
+ * The angle is rounded to RotationStep degrees, so that every draw is a plain pixmap blit.
+ * 
+ * @param painter Painter to draw on
+ * @param target Rect to draw the image in, before rotation
+ * @param angle Clockwise rotation in degrees
  */
-void Sprite::initSpritesCache() {
-    spritesCache = new QMap<QString, QSharedPointer<QImage>>();
-    spritesCache->insert("", QSharedPointer<QImage>(nullptr));
+void Sprite::drawRotated(QPainter* painter, const QRectF& target, qreal angle) const {
+    if (region.page == nullptr) {
+        return;
+    }
+
+    qreal pixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1;
+    QSize size(qRound(target.width() * pixelRatio), qRound(target.height() * pixelRatio));
+    if (size.isEmpty()) {
+        return;
+    }
+
+    int rotation = qRound(angle / RotationStep) * RotationStep % 360;
+    if (rotation < 0) {
+        rotation += 360;
+    }
+    QPixmap pixmap = getScaled(size, pixelRatio, rotation, false);
+
+    // The rotated image grew around the center of the rect
+    QPointF halfSize(pixmap.width() / (2*pixelRatio), pixmap.height() / (2*pixelRatio));
+    painter->drawPixmap(target.center() - halfSize, pixmap);
 }
 
+// --- STATIC ---
+
 /**
- * Delete cache of images.
+ * Delete cache of scaled images. Source images belong to the AssetManager.
  */
 void Sprite::deleteCachedSprites() {
-    delete spritesCache;
-    spritesCache = nullptr;
-}
\ No newline at end of file
+    delete scaledCache;
+    scaledCache = nullptr;
+}
+
+/**
+ * Get the memory used by a scaled pixmap
+ * 
+ * @param pixmap The pixmap
+ * @return Size in bytes
+ */
+qint64 Sprite::getCost(const QPixmap& pixmap) {
+    return qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+/**
+ * Get the amount of scaled images in cache
+ * 
+ * @return Amount of (image, size) pairs currently cached
+ */
+qsizetype Sprite::getScaledCount() {
+    return scaledCache ? scaledCache->size() : 0;
+}
+
+/**
+ * Get the memory used by scaled images in cache
+ * 
+ * @return Size in bytes
+ */
+qint64 Sprite::getScaledBytes() {
+    return scaledCache ? scaledCache->totalCost() : 0;
+}
+
+/**
+ * Set the memory budget of scaled images. Evicts the least recently drawn ones if needed.
+ * 
+ * @param bytes New budget, in bytes
+ */
+void Sprite::setScaledBudget(qint64 bytes) {
+    scaledBudget = bytes;
+    if (scaledCache) {
+        scaledCache->setMaxCost(scaledBudget);
+    }
+}
+
+/**
+ * Get the memory budget of scaled images
+ * 
+ * @return Budget in bytes
+ */
+qint64 Sprite::getScaledBudget() {
+    return scaledBudget;
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <QtDebug>
+#include <QDir>
+#include <QPainter>
+#include "../include/textureAtlas.hpp"
+#include "../include/traceRecorder.hpp"
+
+#define IMAGE_PATH "../res/img/"     // Same folder as AssetManager
+
+// --- BUILD ---
+
+/**
+ * Load every image of res/img, one after the other, and pack the small ones in shared pages.
+ * See AssetPreloader to decode them in parallel instead.
+ */
+void TextureAtlas::build() {
+    TraceSpan span("TextureAtlas::decode", "load");
+    QMap<QString, QImage> images;
+    QStringList filters = { "*.png" };
+    QStringList fileNames = QDir(IMAGE_PATH).entryList(filters, QDir::Files, QDir::Name);
+    for (const QString& fileName : fileNames) {
+        QImage image(IMAGE_PATH + fileName);
+        if (image.isNull()) {
+            qWarning() << "Failed to load image" << fileName;
+        }
+        images.insert(fileName, image);
+    }
+    build(images);
+}
+
+/**
+ * Pack already decoded images in shared pages.
+ * Shelf packing: images sorted by height are laid left to right, a new shelf starts
+ * when a row is full and a new page when a page is full.
+ *
+ * @param images Decoded images, by file name. Null images are skipped, bigger ones are left to AssetManager.
+ */
+void TextureAtlas::build(const QMap<QString, QImage>& images) {
+    TraceSpan span("TextureAtlas::build", "load");
+    clear();
+    regions = new QMap<QString, AtlasRegion>();
+    pages = new QList<QSharedPointer<QImage>>();
+
+    // Keep images that fit in a shared page
+    QList<QPair<QString, QImage>> packed;
+    for (auto it = images.constBegin(); it != images.constEnd(); ++it) {
+        if (!it.value().isNull() && it.value().width() <= MaxPackedSize && it.value().height() <= MaxPackedSize) {
+            packed.append(qMakePair(it.key(), it.value()));
+        }
+    }
+    std::stable_sort(packed.begin(), packed.end(), [](const QPair<QString, QImage>& a, const QPair<QString, QImage>& b) {
+        return a.second.height() > b.second.height();
+    });
+
+    // Place them
+    QList<QPair<QString, QRect>> placements;
+    QList<qsizetype> placementPages;
+    int x = PageSize, y = 0, shelfHeight = 0;
+    for (const QPair<QString, QImage>& entry : packed) {
+        int width = entry.second.width() + Padding;
+        int height = entry.second.height() + Padding;
+        if (x + width > PageSize) {
+            // Next shelf
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = height;
+        }
+        if (pages->isEmpty() || y + height > PageSize) {
+            // Next page
+            QSharedPointer<QImage> page(new QImage(PageSize, PageSize, QImage::Format_ARGB32_Premultiplied));
+            page->fill(Qt::transparent);
+            pages->append(page);
+            x = 0;
+            y = 0;
+            shelfHeight = height;
+        }
+        placements.append(qMakePair(entry.first, QRect(x, y, entry.second.width(), entry.second.height())));
+        placementPages.append(pages->size() - 1);
+        x += width;
+    }
+
+    // Copy images in their pages
+    for (qsizetype i=0; i<placements.size(); i++) {
+        QSharedPointer<QImage> page = pages->at(placementPages.at(i));
+        QPainter painter(page.data());
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(placements.at(i).second.topLeft(), packed.at(i).second);
+        regions->insert(placements.at(i).first, AtlasRegion { page, placements.at(i).second });
+    }
+}
+
+// --- METHODS ---
+
+/**
+ * Know whether the atlas was built
+ *
+ * @return True if pages are in memory
+ */
+bool TextureAtlas::isBuilt() {
+    return regions != nullptr;
+}
+
+/**
+ * Find where an image is packed
+ *
+ * @param fileName Name of image file located in res/img (should look like "foo.png")
+ * @param region Written with the page and rect of the image, if found
+ * @return False if the atlas is not built or the image is not packed
+ */
+bool TextureAtlas::find(const QString& fileName, AtlasRegion* region) {
+    if (regions == nullptr) {
+        return false;
+    }
+
+    auto it = regions->constFind(fileName);
+    if (it == regions->constEnd()) {
+        return false;
+    }
+    *region = it.value();
+    return true;
+}
+
+/**
+ * Get the amount of shared pages
+ *
+ * @return Amount of pages, 0 if the atlas is not built
+ */
+qsizetype TextureAtlas::getPageCount() {
+    return pages ? pages->size() : 0;
+}
+
+/**
+ * Get the amount of images packed in the atlas
+ *
+ * @return Amount of images, 0 if the atlas is not built
+ */
+qsizetype TextureAtlas::getImageCount() {
+    return regions ? regions->size() : 0;
+}
+
+/**
+ * Get the memory used by the pages
+ *
+ * @return Size of all pages, in bytes
+ */
+qint64 TextureAtlas::getBytes() {
+    qint64 bytes = 0;
+    if (pages) {
+        for (const QSharedPointer<QImage>& page : *pages) {
+            bytes += page->sizeInBytes();
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Free every page. Sprites still using a page keep it alive.
+ */
+void TextureAtlas::clear() {
+    delete regions;
+    regions = nullptr;
+    delete pages;
+    pages = nullptr;
+}
@@ -0,0 +1,218 @@
+#include <QDebug>
+#include <QTextStream>
+#include "../include/traceRecorder.hpp"
+
+#define WRITER_PERIOD_MS 5     // Time the writer thread sleeps once the buffer is empty
+#define PROCESS_ID 1
+
+// --- PRIVATE METHODS ---
+
+/**
+ * Get the trace id of the calling thread. Ids are small integers given in order of first use.
+ *
+ * @return Id of the calling thread
+ */
+quint32 TraceRecorder::currentThreadId() {
+    thread_local quint32 id = 0;
+    if (id == 0) {
+        id = threadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return id;
+}
+
+/**
+ * Take the oldest span out of the buffer. Only called by the writer thread.
+ *
+ * @param span Filled with the span
+ * @return False if no span is ready
+ */
+bool TraceRecorder::pop(Span* span) {
+    Slot& slot = buffer[readPos & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != readPos + 1) {
+        return false;
+    }
+
+    *span = slot.span;
+    slot.sequence.store(readPos + Capacity, std::memory_order_release);     // Free for the next lap
+    readPos += 1;
+    return true;
+}
+
+/**
+ * Body of the writer thread: drain the buffer to the file until stop() is called,
+ * then drain what is left and close the JSON document.
+ */
+void TraceRecorder::writeLoop() {
+    QTextStream out(file);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(3);
+
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"args\":{\"name\":\"Mall\"}}";
+
+    Span span;
+    while (true) {
+        bool stopping = !running.load(std::memory_order_acquire);
+        while (pop(&span)) {
+            // Timestamps are in microseconds
+            out << ",\n{\"name\":\"" << span.name << "\",\"cat\":\"" << span.category
+                << "\",\"ph\":\"X\",\"ts\":" << span.start / 1000.0 << ",\"dur\":" << span.duration / 1000.0
+                << ",\"pid\":" << PROCESS_ID << ",\"tid\":" << span.threadId << "}";
+        }
+        if (stopping) {
+            break;
+        }
+        out.flush();
+        QThread::msleep(WRITER_PERIOD_MS);
+    }
+
+    // Name the threads that recorded spans
+    quint32 threads = threadCount.load(std::memory_order_relaxed);
+    for (quint32 id=1; id<=threads; id++) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"tid\":" << id
+            << ",\"args\":{\"name\":\"" << (id == mainThreadId ? "main" : "worker") << "\"}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    out.flush();
+}
+
+// --- METHODS ---
+
+/**
+ * Start recording spans to a trace file
+ *
+ * @param filename Path of the JSON trace file to create
+ * @return False if the file could not be opened or tracing is already on
+ */
+bool TraceRecorder::start(const QString& filename) {
+    if (running.load()) {
+        qWarning() << "Tracing already started";
+        return false;
+    }
+
+    file = new QFile(filename);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open trace file" << filename;
+        delete file;
+        file = nullptr;
+        return false;
+    }
+
+    buffer = new Slot[Capacity];
+    for (quint64 i=0; i<Capacity; i++) {
+        buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writePos.store(0);
+    readPos = 0;
+    dropped.store(0);
+    mainThreadId = currentThreadId();
+    clock.start();
+
+    running.store(true, std::memory_order_release);
+    writer = QThread::create(&TraceRecorder::writeLoop);
+    writer->start();
+    enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Stop recording and finish the trace file.
+ * Must be called once no other thread records spans anymore.
+ */
+void TraceRecorder::stop() {
+    if (!running.load()) {
+        return;
+    }
+
+    enabled.store(false, std::memory_order_release);
+    running.store(false, std::memory_order_release);
+    writer->wait();
+    delete writer;
+    writer = nullptr;
+
+    file->close();
+    delete file;
+    file = nullptr;
+    delete[] buffer;
+    buffer = nullptr;
+
+    if (dropped.load() > 0) {
+        qWarning() << "Trace buffer full," << dropped.load() << "spans dropped";
+    }
+}
+
+/**
+ * Know whether spans are being recorded
+ *
+ * @return True between start() and stop()
+ */
+bool TraceRecorder::isEnabled() {
+    return enabled.load(std::memory_order_acquire);
+}
+
+/**
+ * Get the current trace timestamp
+ *
+ * @return Nanoseconds since start()
+ */
+qint64 TraceRecorder::now() {
+    return clock.nsecsElapsed();
+}
+
+/**
+ * Record a finished span. Lock-free: any thread can call it while tracing is on.
+ *
+ * @param name Name of the span (string literal)
+ * @param category Category of the span (string literal)
+ * @param start, end Timestamps of the span, from now()
+ */
+void TraceRecorder::addSpan(const char* name, const char* category, qint64 start, qint64 end) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    // Claim a position whose slot has been freed by the writer
+    quint64 pos = writePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &buffer[pos & (Capacity - 1)];
+        qint64 diff = qint64(slot->sequence.load(std::memory_order_acquire)) - qint64(pos);
+        if (diff == 0) {
+            if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // Writer is a whole lap behind: drop rather than stall the simulation
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = writePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->span = Span{name, category, start, end - start, currentThreadId()};
+    slot->sequence.store(pos + 1, std::memory_order_release);     // Ready for the writer
+}
+
+// --- TRACE SPAN ---
+
+/**
+ * Constructor. Starts the span.
+ *
+ * @param name Name of the span (string literal)
+ * @param category Category of the span (string literal)
+ */
+TraceSpan::TraceSpan(const char* name, const char* category) : name(name), category(category) {
+    start = TraceRecorder::isEnabled() ? TraceRecorder::now() : -1;
+}
+
+/**
+ * Destructor. Records the span.
+ */
+TraceSpan::~TraceSpan() {
+    if (start >= 0) {
+        TraceRecorder::addSpan(name, category, start, TraceRecorder::now());
+    }
+}
@@ -0,0 +1,190 @@
+#include "../include/vector2Batch.hpp"
+
+// SIMD paths work on doubles: disabled when Qt is built with another qreal
+#if !defined(QT_COORD_TYPE) && defined(__AVX__)
+#define VECTOR2BATCH_AVX
+#define VECTOR2BATCH_SSE2
+#include <immintrin.h>
+#elif !defined(QT_COORD_TYPE) && (defined(__SSE2__) || defined(_M_X64))
+#define VECTOR2BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+// --- SINGLE VECTOR KERNELS ---
+
+#ifdef VECTOR2BATCH_SSE2
+/**
+ * Normalize one vector in place. Null vectors are kept as they are, like Vector2::normalized().
+ *
+ * @param data Coordinates of the vector
+ */
+static inline void normalizeOne(double* data) {
+    __m128d v = _mm_loadu_pd(data);
+    __m128d sq = _mm_mul_pd(v, v);
+    __m128d mag = _mm_sqrt_pd(_mm_add_pd(sq, _mm_shuffle_pd(sq, sq, 1)));     // x*x + y*y in both lanes
+    __m128d nonZero = _mm_cmpneq_pd(mag, _mm_setzero_pd());
+    __m128d result = _mm_or_pd(_mm_and_pd(nonZero, _mm_div_pd(v, mag)), _mm_andnot_pd(nonZero, v));
+    _mm_storeu_pd(data, result);
+}
+
+/**
+ * Distance between two points
+ *
+ * @param from, to Coordinates of the points
+ * @param distance Written with the distance
+ */
+static inline void distanceOne(const double* from, const double* to, double* distance) {
+    __m128d d = _mm_sub_pd(_mm_loadu_pd(from), _mm_loadu_pd(to));
+    __m128d sq = _mm_mul_pd(d, d);
+    _mm_store_sd(distance, _mm_sqrt_pd(_mm_add_pd(sq, _mm_shuffle_pd(sq, sq, 1))));
+}
+
+/**
+ * Add a scaled delta to a vector
+ *
+ * @param target Coordinates of the vector to move
+ * @param delta Coordinates of the delta
+ * @param scale Factor applied to the delta
+ */
+static inline void addScaledOne(double* target, const double* delta, double scale) {
+    __m128d moved = _mm_add_pd(_mm_loadu_pd(target), _mm_mul_pd(_mm_loadu_pd(delta), _mm_set1_pd(scale)));
+    _mm_storeu_pd(target, moved);
+}
+#endif
+
+// --- BATCH KERNELS ---
+
+/**
+ * Get the instruction set the kernels were built for
+ *
+ * @return "avx", "sse2" or "scalar"
+ */
+const char* Vector2Batch::getInstructionSet() {
+#if defined(VECTOR2BATCH_AVX)
+    return "avx";
+#elif defined(VECTOR2BATCH_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * Normalize every vector in place. Null vectors are kept as they are.
+ *
+ * @param vectors Vectors to normalize
+ * @param count Amount of vectors
+ */
+void Vector2Batch::normalize(Vector2* vectors, qsizetype count) {
+    qsizetype i = 0;
+#ifdef VECTOR2BATCH_SSE2
+    double* data = reinterpret_cast<double*>(vectors);
+#ifdef VECTOR2BATCH_AVX
+    for (; i+2 <= count; i += 2) {
+        __m256d v = _mm256_loadu_pd(data + 2*i);
+        __m256d sq = _mm256_mul_pd(v, v);
+        __m256d mag = _mm256_sqrt_pd(_mm256_add_pd(sq, _mm256_permute_pd(sq, 0b0101)));
+        __m256d nonZero = _mm256_cmp_pd(mag, _mm256_setzero_pd(), _CMP_NEQ_UQ);
+        _mm256_storeu_pd(data + 2*i, _mm256_blendv_pd(v, _mm256_div_pd(v, mag), nonZero));
+    }
+#endif
+    for (; i < count; i++) {
+        normalizeOne(data + 2*i);
+    }
+#else
+    for (; i < count; i++) {
+        vectors[i] = vectors[i].normalized();
+    }
+#endif
+}
+
+/**
+ * Compute the distance between pairs of points
+ *
+ * @param from, to Points of each pair
+ * @param distances Written with the distance of each pair
+ * @param count Amount of pairs
+ */
+void Vector2Batch::distance(const Vector2* from, const Vector2* to, qreal* distances, qsizetype count) {
+    qsizetype i = 0;
+#ifdef VECTOR2BATCH_SSE2
+    const double* fromData = reinterpret_cast<const double*>(from);
+    const double* toData = reinterpret_cast<const double*>(to);
+#ifdef VECTOR2BATCH_AVX
+    for (; i+2 <= count; i += 2) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(fromData + 2*i), _mm256_loadu_pd(toData + 2*i));
+        __m256d sq = _mm256_mul_pd(d, d);
+        __m256d sum = _mm256_add_pd(sq, _mm256_permute_pd(sq, 0b0101));      // Pair sums, each twice
+        __m128d pairs = _mm_unpacklo_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+        _mm_storeu_pd(distances + i, _mm_sqrt_pd(pairs));
+    }
+#endif
+    for (; i < count; i++) {
+        distanceOne(fromData + 2*i, toData + 2*i, distances + i);
+    }
+#else
+    for (; i < count; i++) {
+        distances[i] = from[i].distanceWith(to[i]);
+    }
+#endif
+}
+
+/**
+ * Move every vector by the matching delta times a common factor: targets[i] += deltas[i] * scale
+ *
+ * @param targets Vectors to move
+ * @param deltas Delta of each vector
+ * @param scale Factor applied to every delta
+ * @param count Amount of vectors
+ */
+void Vector2Batch::addScaled(Vector2* targets, const Vector2* deltas, qreal scale, qsizetype count) {
+    qsizetype i = 0;
+#ifdef VECTOR2BATCH_SSE2
+    double* targetData = reinterpret_cast<double*>(targets);
+    const double* deltaData = reinterpret_cast<const double*>(deltas);
+#ifdef VECTOR2BATCH_AVX
+    __m256d scales = _mm256_set1_pd(scale);
+    for (; i+2 <= count; i += 2) {
+        __m256d moved = _mm256_add_pd(_mm256_loadu_pd(targetData + 2*i), _mm256_mul_pd(_mm256_loadu_pd(deltaData + 2*i), scales));
+        _mm256_storeu_pd(targetData + 2*i, moved);
+    }
+#endif
+    for (; i < count; i++) {
+        addScaledOne(targetData + 2*i, deltaData + 2*i, scale);
+    }
+#else
+    for (; i < count; i++) {
+        targets[i] = targets[i] + deltas[i] * scale;
+    }
+#endif
+}
+
+/**
+ * Move every vector by the matching delta times its own factor: targets[i] += deltas[i] * scales[i]
+ *
+ * @param targets Vectors to move
+ * @param deltas Delta of each vector
+ * @param scales Factor of each delta
+ * @param count Amount of vectors
+ */
+void Vector2Batch::addScaled(Vector2* targets, const Vector2* deltas, const qreal* scales, qsizetype count) {
+    qsizetype i = 0;
+#ifdef VECTOR2BATCH_SSE2
+    double* targetData = reinterpret_cast<double*>(targets);
+    const double* deltaData = reinterpret_cast<const double*>(deltas);
+#ifdef VECTOR2BATCH_AVX
+    for (; i+2 <= count; i += 2) {
+        __m256d factors = _mm256_set_pd(scales[i+1], scales[i+1], scales[i], scales[i]);
+        __m256d moved = _mm256_add_pd(_mm256_loadu_pd(targetData + 2*i), _mm256_mul_pd(_mm256_loadu_pd(deltaData + 2*i), factors));
+        _mm256_storeu_pd(targetData + 2*i, moved);
+    }
+#endif
+    for (; i < count; i++) {
+        addScaledOne(targetData + 2*i, deltaData + 2*i, scales[i]);
+    }
+#else
+    for (; i < count; i++) {
+        targets[i] = targets[i] + deltas[i] * scales[i];
+    }
+#endif
+}
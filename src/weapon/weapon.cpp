@@ -1,11 +1,5 @@
-#include <QFile>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include "../../include/weapon/weapon.hpp"
-#include "../../include/weapon/gun.hpp"
-#include "../../include/weapon/rocketLauncher.hpp"
-
-#define WEAPONINFO_PATH "../res/weapon/"
+#include "../../include/weapon/weaponRegistry.hpp"
 
 /**
  * Default constructor
@@ -41,38 +35,13 @@ Weapon::~Weapon() {
 }
 
 /**
- * Pattern factory.
+ * Pattern factory. Clones the prototype loaded by WeaponRegistry: does not read the disk.
  * 
- * @param filename Weapon json file name
+ * @param filename Weapon json file name (should look like "gun/foo.json")
  * @return A new weapon. nullptr if failed.
  */
 Weapon* Weapon::create(const QString& filename) {
-    // Open file
-    QFile file = QFile(WEAPONINFO_PATH + filename);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Failed to open file" << (WEAPONINFO_PATH + filename);
-        return nullptr;
-    }
-
-    // Parse JSON
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    if (doc.isNull()) {
-        qWarning() << "Failed to parse JSON data.";
-        return nullptr;
-    }
-
-    QJsonObject obj = doc.object();
-    QString type = obj["type"].toString();
-    // Create weapon depending on type
-    if (type == "Gun") {
-        return new Gun(obj);
-    }
-    else if (type == "RocketLauncher") {
-        return new RocketLauncher(obj);
-    }
-    else {
-        return nullptr;
-    }
+    return WeaponRegistry::create(WeaponRegistry::getId(filename));
 }
 
 // --- METHODS ---
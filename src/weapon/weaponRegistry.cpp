@@ -0,0 +1,176 @@
+#include <QtDebug>
+#include <QFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "../../include/weapon/weaponRegistry.hpp"
+#include "../../include/weapon/gun.hpp"
+#include "../../include/weapon/rocketLauncher.hpp"
+#include "../../include/traceRecorder.hpp"
+
+#define WEAPONINFO_PATH "../res/weapon/"
+
+// Nothing here (static)
+WeaponRegistry::WeaponRegistry() { }
+WeaponRegistry::~WeaponRegistry() { }
+
+// --- LOADING ---
+
+/**
+ * Read a weapon definition from the disk
+ *
+ * @param filename Weapon json file name, relative to res/weapon (should look like "gun/foo.json")
+ * @return A new weapon. nullptr if failed.
+ */
+Weapon* WeaponRegistry::loadFile(const QString& filename) {
+    // Open file
+    QFile file = QFile(WEAPONINFO_PATH + filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file" << (WEAPONINFO_PATH + filename);
+        return nullptr;
+    }
+
+    // Parse JSON
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (doc.isNull()) {
+        qWarning() << "Failed to parse JSON data.";
+        return nullptr;
+    }
+
+    QJsonObject obj = doc.object();
+    QString type = obj["type"].toString();
+    // Create weapon depending on type
+    if (type == "Gun") {
+        return new Gun(obj);
+    }
+    else if (type == "RocketLauncher") {
+        return new RocketLauncher(obj);
+    }
+    else {
+        qWarning() << "Weapon type" << type << "is unknown";
+        return nullptr;
+    }
+}
+
+/**
+ * Load every weapon definition of res/weapon. Ids follow the sorted file names.
+ * Automatically called when a weapon is looked for the first time.
+ * Call it ahead of time (see AssetPreloader) so that the first drop does not read the disk.
+ */
+void WeaponRegistry::load() {
+    TraceSpan span("WeaponRegistry::load", "load");
+    clear();
+    ids = new QHash<QString, WeaponId>();
+    prototypes = new QList<const Weapon*>();
+    filenames = new QStringList();
+
+    QDir weaponDir(WEAPONINFO_PATH);
+    QStringList jsonFilters = { "*.json" };
+    for (const QString& type : weaponDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+        for (const QString& file : QDir(WEAPONINFO_PATH + type).entryList(jsonFilters, QDir::Files, QDir::Name)) {
+            QString filename = type + "/" + file;
+            Weapon* weapon = loadFile(filename);
+            if (!weapon || weapon->isEmpty()) {
+                qWarning() << "Weapon at" << filename << "is empty";
+                delete weapon;
+                continue;
+            }
+            ids->insert(filename, prototypes->size());
+            prototypes->append(weapon);
+            filenames->append(filename);
+        }
+    }
+}
+
+// --- METHODS ---
+
+/**
+ * Know whether definitions were loaded
+ *
+ * @return True if prototypes are in memory
+ */
+bool WeaponRegistry::isLoaded() {
+    return prototypes != nullptr;
+}
+
+/**
+ * Get the id of a weapon definition
+ *
+ * @param filename Weapon json file name, relative to res/weapon (should look like "gun/foo.json")
+ * @return Id of the weapon, InvalidId if there is no such definition
+ */
+WeaponId WeaponRegistry::getId(const QString& filename) {
+    if (!isLoaded()) {
+        load();
+    }
+
+    WeaponId id = ids->value(filename, InvalidId);
+    if (id == InvalidId) {
+        qWarning() << "Weapon" << filename << "is unknown";
+    }
+    return id;
+}
+
+/**
+ * Get the file a weapon definition was read from
+ *
+ * @param id Id of the weapon
+ * @return File name relative to res/weapon, "" if the id is invalid
+ */
+QString WeaponRegistry::getFilename(WeaponId id) {
+    if (!isLoaded() || id < 0 || id >= filenames->size()) {
+        return "";
+    }
+    return filenames->at(id);
+}
+
+/**
+ * Get the amount of weapon definitions
+ *
+ * @return Amount of prototypes, 0 if not loaded
+ */
+qsizetype WeaponRegistry::getCount() {
+    return prototypes ? prototypes->size() : 0;
+}
+
+/**
+ * Get the prototype of a weapon
+ *
+ * @param id Id of the weapon
+ * @return The prototype, not to be modified nor deleted. nullptr if the id is invalid
+ */
+const Weapon* WeaponRegistry::getPrototype(WeaponId id) {
+    if (!isLoaded()) {
+        load();
+    }
+    if (id < 0 || id >= prototypes->size()) {
+        return nullptr;
+    }
+    return prototypes->at(id);
+}
+
+/**
+ * Create a weapon by cloning its prototype
+ *
+ * @param id Id of the weapon
+ * @return A new weapon (allocated using new keyword). nullptr if the id is invalid
+ */
+Weapon* WeaponRegistry::create(WeaponId id) {
+    const Weapon* prototype = getPrototype(id);
+    return prototype ? prototype->clone() : nullptr;
+}
+
+/**
+ * Delete every prototype. Weapons cloned from them are not affected.
+ */
+void WeaponRegistry::clear() {
+    if (prototypes) {
+        qDeleteAll(*prototypes);
+    }
+    delete prototypes;
+    prototypes = nullptr;
+    delete ids;
+    ids = nullptr;
+    delete filenames;
+    filenames = nullptr;
+}